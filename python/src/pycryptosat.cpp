@@ -44,7 +44,11 @@ typedef struct {
     PyObject_HEAD
     /* Type-specific fields go here. */
     SATSolver* cmsat;
-    std::vector<Lit> tmp_cl_lits;
+    // Heap allocated: PyType_GenericNew never runs C++ constructors
+    std::vector<Lit>* tmp_cl_lits;
+    std::vector<int32_t>* tmp_flat_lits;
+    // Set while solve()/simplify() runs without the GIL
+    bool busy;
 
     int verbose;
     double time_limit;
@@ -72,6 +76,7 @@ static void setup_solver(Solver *self, PyObject *args, PyObject *kwds)
 
     int num_threads = 1;
     self->cmsat = NULL;
+    self->busy = false;
     self->verbose = 0;
     self->time_limit = std::numeric_limits<double>::max();
     self->confl_limit = std::numeric_limits<long>::max();
@@ -108,6 +113,17 @@ static void setup_solver(Solver *self, PyObject *args, PyObject *kwds)
     return;
 }
 
+// The GIL is released while solving, so another Python thread could call
+// into the same solver. Only interrupt() is safe to call then.
+static int check_not_busy(Solver *self)
+{
+    if (self->busy) {
+        PyErr_SetString(PyExc_RuntimeError, "solver is busy solving in another thread");
+        return 0;
+    }
+    return 1;
+}
+
 static int convert_lit_to_sign_and_var(PyObject* lit, long& var, bool& sign)
 {
     if (!IS_INT(lit))  {
@@ -217,11 +233,11 @@ static int parse_xor_clause(
 
 static int _add_clause(Solver *self, PyObject *clause)
 {
-    self->tmp_cl_lits.clear();
-    if (!parse_clause(self, clause, self->tmp_cl_lits)) {
+    self->tmp_cl_lits->clear();
+    if (!parse_clause(self, clause, *self->tmp_cl_lits)) {
         return 0;
     }
-    self->cmsat->add_clause(self->tmp_cl_lits);
+    self->cmsat->add_clause(*self->tmp_cl_lits);
 
     return 1;
 }
@@ -243,6 +259,9 @@ static PyObject* add_clause(Solver *self, PyObject *args, PyObject *kwds)
     if (!PyArg_ParseTupleAndKeywords(args, kwds, "O", const_cast<char**>(kwlist), &clause)) {
         return NULL;
     }
+    if (!check_not_busy(self)) {
+        return NULL;
+    }
 
     if (_add_clause(self, clause) == 0 ) {
         return NULL;
@@ -263,35 +282,47 @@ static int _add_clauses_from_array(Solver *self, const size_t array_length, cons
         PyErr_SetString(PyExc_ValueError, "last clause not terminated by zero");
         return 0;
     }
-    size_t k = 0;
-    long val = 0;
-    std::vector<Lit>& lits = self->tmp_cl_lits;
-    for (val = (long) array[k]; k < array_length; val = (long) array[++k]) {
-        lits.clear();
-        long int max_var = 0;
-        for (; k < array_length && val != 0; val = (long) array[++k]) {
-            long var;
-            bool sign;
-            if (val > std::numeric_limits<int>::max()/2
-                || val < std::numeric_limits<int>::min()/2
-            ) {
-                PyErr_Format(PyExc_ValueError, "integer %ld is too small or too large", val);
-                return 0;
-            }
-
-            sign = (val < 0);
-            var = std::abs(val) - 1;
-            max_var = std::max(var, max_var);
 
-            lits.push_back(Lit(var, sign));
-        }
-        if (!lits.empty()) {
-            if (max_var >= (long int)self->cmsat->nVars()) {
-                self->cmsat->new_vars(max_var-(long int)self->cmsat->nVars()+1);
+    // Validate the whole array first, so nothing is added on error, and
+    // find the largest variable so it only has to be created once
+    long max_var = -1;
+    bool has_empty = false;
+    for (size_t k = 0; k < array_length; k++) {
+        const long val = (long) array[k];
+        if (val == 0) {
+            if (k == 0 || array[k-1] == 0) {
+                has_empty = true;
             }
-            self->cmsat->add_clause(lits);
+            continue;
+        }
+        if (val > std::numeric_limits<int>::max()/2
+            || val < std::numeric_limits<int>::min()/2
+        ) {
+            PyErr_Format(PyExc_ValueError, "integer %ld is too small or too large", val);
+            return 0;
         }
+        max_var = std::max(std::abs(val) - 1, max_var);
     }
+    if (max_var >= (long int)self->cmsat->nVars()) {
+        self->cmsat->new_vars(max_var-(long int)self->cmsat->nVars()+1);
+    }
+
+    // 32b literals can be handed to the solver as they are. Everything else
+    // is narrowed into a scratch buffer. Empty clauses are skipped, as before.
+    if (sizeof(T) == sizeof(int32_t) && !has_empty) {
+        self->cmsat->add_clauses((const int32_t*) array, array_length);
+        return 1;
+    }
+    std::vector<int32_t>& flat = *self->tmp_flat_lits;
+    flat.clear();
+    flat.reserve(array_length);
+    for (size_t k = 0; k < array_length; k++) {
+        if (array[k] == 0 && (flat.empty() || flat.back() == 0)) {
+            continue;
+        }
+        flat.push_back((int32_t) array[k]);
+    }
+    self->cmsat->add_clauses(flat.data(), flat.size());
     return 1;
 }
 
@@ -343,6 +374,9 @@ static PyObject* add_clauses(Solver *self, PyObject *args, PyObject *kwds)
     if (!PyArg_ParseTupleAndKeywords(args, kwds, "O", const_cast<char**>(kwlist), &clauses)) {
         return NULL;
     }
+    if (!check_not_busy(self)) {
+        return NULL;
+    }
 
     if (PyObject_CheckBuffer(clauses)) {
         Py_buffer view;
@@ -392,6 +426,9 @@ static PyObject* add_xor_clause(Solver *self, PyObject *args, PyObject *kwds)
     if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO", const_cast<char**>(kwlist), &clause, &rhs)) {
         return NULL;
     }
+    if (!check_not_busy(self)) {
+        return NULL;
+    }
     if (!PyBool_Check(rhs)) {
         PyErr_SetString(PyExc_TypeError, "rhs must be boolean");
         return NULL;
@@ -479,8 +516,11 @@ Return the number of literals in the solver.\n\
 
 static PyObject* nb_vars(Solver *self)
 {
-    return PyLong_FromLong(self->cmsat->nVars());
+    if (!check_not_busy(self)) {
+        return NULL;
+    }
 
+    return PyLong_FromLong(self->cmsat->nVars());
 }
 
 static int parse_assumption_lits(PyObject* assumptions, SATSolver* cmsat, std::vector<Lit>& assumption_lits)
@@ -590,6 +630,9 @@ static PyObject* solve(Solver *self, PyObject *args, PyObject *kwds)
         PyErr_SetString(PyExc_ValueError, "conflict limit must be at least 0");
         return NULL;
     }
+    if (!check_not_busy(self)) {
+        return NULL;
+    }
 
     std::vector<Lit> assumption_lits;
     if (assumptions) {
@@ -609,9 +652,13 @@ static PyObject* solve(Solver *self, PyObject *args, PyObject *kwds)
     }
 
     lbool res;
+    self->busy = true;
+    // Still under the GIL: an interrupt() once it's released is kept
+    self->cmsat->clear_interrupt_asap();
     Py_BEGIN_ALLOW_THREADS      /* release GIL */
     res = self->cmsat->solve(&assumption_lits);
     Py_END_ALLOW_THREADS
+    self->busy = false;
 
     self->cmsat->set_verbosity(self->verbose);
     self->cmsat->set_max_time(self->time_limit);
@@ -651,6 +698,117 @@ static PyObject* solve(Solver *self, PyObject *args, PyObject *kwds)
     return result;
 }
 
+PyDoc_STRVAR(get_model_doc,
+"get_model()\n\
+Return the model of the last satisfiable solve() without creating a Python\n\
+object per variable. Useful for large instances, e.g. with\n\
+numpy.frombuffer(solver.get_model(), dtype=numpy.int8)\n\
+\n\
+:return: Buffer of signed bytes preceded by a 0, so you can index into it\n\
+    with the variable number. 1 means True, -1 False and 0 unassigned.\n\
+:rtype: <memoryview>"
+);
+
+static PyObject* get_model(Solver *self)
+{
+    if (!check_not_busy(self)) {
+        return NULL;
+    }
+
+    const std::vector<lbool>& model = self->cmsat->get_model();
+    const size_t max_idx = self->cmsat->nVars();
+
+    PyObject* bytes = PyByteArray_FromStringAndSize(NULL, (Py_ssize_t) max_idx+1);
+    if (bytes == NULL) {
+        return NULL;
+    }
+    char* vals = PyByteArray_AS_STRING(bytes);
+    vals[0] = 0;
+    for (size_t i = 0; i < max_idx; i++) {
+        const lbool v = i < model.size() ? model[i] : l_Undef;
+        vals[i+1] = (v == l_True) ? 1 : ((v == l_False) ? -1 : 0);
+    }
+
+    // bytearray exports unsigned bytes, expose them as signed
+    PyObject* view = PyMemoryView_FromObject(bytes);
+    Py_DECREF(bytes);
+    if (view == NULL) {
+        return NULL;
+    }
+    PyObject* ret = PyObject_CallMethod(view, "cast", "s", "b");
+    Py_DECREF(view);
+    return ret;
+}
+
+PyDoc_STRVAR(simplify_doc,
+"simplify(assumptions=None)\n\
+Simplify the system of equations that have been added with add_clause(),\n\
+without solving it. Releases the GIL while running.\n\
+\n\
+:param assumptions: (Optional) Variables that must not be simplified away,\n\
+    as they will be used as assumptions later.\n\
+:type assumptions: <list>\n\
+:return: False if the system was found to be unsatisfiable, True if it was\n\
+    found to be satisfiable, None otherwise.\n\
+:rtype: <boolean>"
+);
+
+static PyObject* simplify(Solver *self, PyObject *args, PyObject *kwds)
+{
+    PyObject* assumptions = NULL;
+
+    static char const* kwlist[] = {"assumptions", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "|O", const_cast<char**>(kwlist), &assumptions)) {
+        return NULL;
+    }
+    if (!check_not_busy(self)) {
+        return NULL;
+    }
+
+    std::vector<Lit> assumption_lits;
+    if (assumptions) {
+        if (!parse_assumption_lits(assumptions, self->cmsat, assumption_lits)) {
+            return NULL;
+        }
+    }
+
+    lbool res;
+    self->busy = true;
+    // Still under the GIL: an interrupt() once it's released is kept
+    self->cmsat->clear_interrupt_asap();
+    Py_BEGIN_ALLOW_THREADS      /* release GIL */
+    res = self->cmsat->simplify(&assumption_lits);
+    Py_END_ALLOW_THREADS
+    self->busy = false;
+
+    if (res == l_True) {
+        Py_INCREF(Py_True);
+        return Py_True;
+    } else if (res == l_False) {
+        Py_INCREF(Py_False);
+        return Py_False;
+    }
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
+PyDoc_STRVAR(interrupt_doc,
+"interrupt()\n\
+Ask the solve() or simplify() currently running in another thread to stop as\n\
+soon as possible. It will then return as if its limits had been reached. Has\n\
+no effect on later calls.\n\
+\n\
+:return: None\n\
+:rtype: <None>"
+);
+
+static PyObject* interrupt(Solver *self)
+{
+    self->cmsat->interrupt_asap();
+    Py_INCREF(Py_None);
+    return Py_None;
+}
+
 PyDoc_STRVAR(is_satisfiable_doc,
 "is_satisfiable()\n\
 Return satisfiability of the system.\n\
@@ -661,10 +819,18 @@ Return satisfiability of the system.\n\
 
 static PyObject* is_satisfiable(Solver *self)
 {
+    if (!check_not_busy(self)) {
+        return NULL;
+    }
+
     lbool res;
+    self->busy = true;
+    // Still under the GIL: an interrupt() once it's released is kept
+    self->cmsat->clear_interrupt_asap();
     Py_BEGIN_ALLOW_THREADS      /* release GIL */
     res = self->cmsat->solve();
     Py_END_ALLOW_THREADS
+    self->busy = false;
 
     if (res == l_True) {
         Py_INCREF(Py_True);
@@ -692,6 +858,10 @@ was unsatisfiable.\n\
 
 static PyObject* get_conflict(Solver *self)
 {
+    if (!check_not_busy(self)) {
+        return NULL;
+    }
+
     const std::vector<Lit> conflicts = self->cmsat->get_conflict();
     PyObject *result = PyList_New(0);
 
@@ -719,8 +889,11 @@ static PyMethodDef Solver_methods[] = {
     {"add_xor_clause",(PyCFunction) add_xor_clause,  METH_VARARGS | METH_KEYWORDS, "adds an XOR clause to the system"},
     {"nb_vars", (PyCFunction) nb_vars, METH_VARARGS | METH_KEYWORDS, nb_vars_doc},
     //{"nb_clauses", (PyCFunction) nb_clauses, METH_VARARGS | METH_KEYWORDS, "returns number of clauses"},
+    {"simplify", (PyCFunction) simplify, METH_VARARGS | METH_KEYWORDS, simplify_doc},
+    {"interrupt", (PyCFunction) interrupt, METH_VARARGS | METH_KEYWORDS, interrupt_doc},
     {"is_satisfiable", (PyCFunction) is_satisfiable, METH_VARARGS | METH_KEYWORDS, is_satisfiable_doc},
     {"get_conflict", (PyCFunction) get_conflict, METH_VARARGS | METH_KEYWORDS, get_conflict_doc},
+    {"get_model", (PyCFunction) get_model, METH_VARARGS | METH_KEYWORDS, get_model_doc},
     {NULL,        NULL}  /* sentinel - marks the end of this structure */
 };
 
@@ -728,15 +901,26 @@ static void
 Solver_dealloc(Solver* self)
 {
     delete self->cmsat;
+    delete self->tmp_cl_lits;
+    delete self->tmp_flat_lits;
     Py_TYPE(self)->tp_free ((PyObject*) self);
 }
 
 static int
 Solver_init(Solver *self, PyObject *args, PyObject *kwds)
 {
+    if (!check_not_busy(self)) {
+        return -1;
+    }
     if (self->cmsat != NULL) {
         delete self->cmsat;
     }
+    if (self->tmp_cl_lits == NULL) {
+        self->tmp_cl_lits = new std::vector<Lit>;
+    }
+    if (self->tmp_flat_lits == NULL) {
+        self->tmp_flat_lits = new std::vector<int32_t>;
+    }
 
     setup_solver(self, args, kwds);
     if (!self->cmsat) {
@@ -27,6 +27,7 @@ import os
 import sys
 import unittest
 import time
+import threading
 
 
 import pycryptosat
@@ -230,6 +231,31 @@ class TestSolve(unittest.TestCase):
         cls = array('i', [1, 2, 0, 1, 2])
         self.assertRaises(ValueError, self.solver.add_clause, cls)
 
+    def test_add_clauses_array_long(self):
+        cls = array('l', [1, 2, 0, 0, -1, 0, -2, 3, 0])
+        self.solver.add_clauses(cls)
+        res, solution = self.solver.solve()
+        self.assertEqual(res, True)
+        self.assertEqual(solution, (None, False, True, True))
+
+    def test_add_clauses_array_too_large(self):
+        cls = array('l', [1, 0, 2**40, 0])
+        self.assertRaises(ValueError, self.solver.add_clauses, cls)
+        self.assertEqual(self.solver.nb_vars(), 0)
+
+    def test_get_model(self):
+        self.solver.add_clauses(array('i', [1, 0, -2, 0, 1, 3, 0]))
+        res, solution = self.solver.solve()
+        self.assertEqual(res, True)
+        model = self.solver.get_model()
+        self.assertEqual(len(model), 4)
+        self.assertEqual(model.format, 'b')
+        self.assertEqual(model[0], 0)
+        self.assertEqual(model[1], 1)
+        self.assertEqual(model[2], -1)
+        for i in range(1, 4):
+            self.assertEqual(model[i] == 1, solution[i])
+
     def test_bad_iter(self):
         class Liar:
 
@@ -332,6 +358,54 @@ class TestSolveTimeLimit(unittest.TestCase):
         # systems, but not on overloaded CI servers
         self.assertLess(took_time, 4)
 
+
+class TestConcurrent(unittest.TestCase):
+
+    get_clauses = TestSolveTimeLimit.get_clauses
+
+    def test_interrupt(self):
+        solver = Solver()
+        solver.add_clauses(self.get_clauses())
+        timer = threading.Timer(0.5, solver.interrupt)
+        t0 = time.time()
+        timer.start()
+        sat, sol = solver.solve()
+        took_time = time.time() - t0
+        timer.join()
+        self.assertEqual(sat, None)
+        self.assertLess(took_time, 4)
+
+    def test_busy(self):
+        solver = Solver()
+        solver.add_clauses(self.get_clauses())
+        thread = threading.Thread(target=solver.solve)
+        thread.start()
+        time.sleep(0.2)
+        self.assertRaises(RuntimeError, solver.add_clause, [1])
+        self.assertRaises(RuntimeError, solver.solve)
+        self.assertRaises(RuntimeError, solver.get_model)
+        self.assertRaises(RuntimeError, solver.__init__)
+        solver.interrupt()
+        thread.join()
+        solver.add_clause([1])
+
+    def test_many_solvers(self):
+        results = [None]*8
+
+        def work(i):
+            solver = Solver()
+            solver.add_clauses(clauses1)
+            solver.add_clause([i % 5 + 1])
+            self.assertNotEqual(solver.simplify(), False)
+            results[i] = solver.solve()[0]
+
+        threads = [threading.Thread(target=work, args=(i,)) for i in range(8)]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+        self.assertEqual(results, [True]*8)
+
 # ------------------------------------------------------------------------
 
 
@@ -348,6 +422,7 @@ def run():
     suite.addTest(unittest.makeSuite(TestSolve))
     suite.addTest(unittest.makeSuite(TestDump))
     suite.addTest(unittest.makeSuite(TestSolveTimeLimit))
+    suite.addTest(unittest.makeSuite(TestConcurrent))
 
     runner = unittest.TextTestRunner(verbosity=2)
     result = runner.run(suite)
@@ -305,6 +305,8 @@ class Tester:
         # SLS
         cmd += "--sls %d " % random.choice([0, 1])
         cmd += "--slsgetphase %d " % random.choice([0, 0, 0, 1])
+        cmd += "--slswalkers %d " % random.choice([1, 1, 2])
+        cmd += "--slstype %s " % random.choice(["ccnr", "ccnr", "probsat", "auto"])
         cmd += "--yalsatmems %d " % random.choice([1, 2, 5])
         cmd += "--walksatruns %d " % random.choice([2, 15, 20])
 
@@ -313,6 +315,20 @@ class Tester:
 
         cmd += "--mustrenumber %d " % random.choice([0, 1])
         cmd += "--diffdeclevelchrono %d " % random.choice([1, random.randint(1, 1000), -1])
+        cmd += "--confltochrono %d " % random.choice([0, random.randint(1, 10000), -1])
+        cmd += "--reusetrail %d " % random.choice([0, 1])
+        cmd += "--rephase %d " % random.choice([0, 1])
+        cmd += "--rephasefirst %d " % random.choice([1000, random.randint(1, 5000)])
+        cmd += "--modeswitch %d " % random.choice([0, 1])
+        cmd += "--modeswitchfirst %d " % random.choice([2000, random.randint(1, 10000)])
+        cmd += "--rstfirststable %d " % random.choice([1000, random.randint(1, 2000)])
+        cmd += "--vsidsheap %d " % random.choice([2, 4, 8])
+        cmd += "--shrink %d " % random.choice([0, 1])
+        cmd += "--vivif %d " % random.choice([0, 1])
+        cmd += "--viveff %s " % random.choice(["0.01", "0.03", "0.2"])
+        cmd += "--adaptsched %d " % random.choice([0, 1])
+        cmd += "--adaptschedretry %d " % random.choice([0, 1, 4, 20])
+        cmd += "--inproceffort %s " % random.choice(["0", "0.2", "1.0", "5.0"])
         cmd += "--bvaeveryn %d " % random.choice([1, random.randint(1, 20)])
 
         if self.only_sampling:
@@ -346,6 +362,7 @@ class Tester:
             cmd += "--occredmaxmb %s " % random.gammavariate(0.2, 5)
             cmd += "--implsubsto %s " % random.choice([0, 10, 1000])
             cmd += "--sync %d " % random.choice([100, 1000, 6000, 100000])
+            cmd += "--proofbufs %d " % random.choice([0, 1, 2, 8])
             cmd += "-m %0.12f " % random.gammavariate(0.1, 5.0)
             cmd += "--maxsccdepth %d " % random.choice([0, 1, 100, 100000])
 
@@ -595,7 +612,7 @@ class Tester:
         self.this_gauss_on = "autodisablegauss" in self.extra_opts_supported
 
         # frat turns off a bunch of systems, like symmetry breaking so use it about 50% of time
-        self.frat = self.num_threads == 1 and (random.randint(0, 10) < 10)
+        self.frat = random.randint(0, 10) < 10
 
 
         self.sqlitedbfname = None
@@ -65,6 +65,7 @@ def gen_modules(version):
                    "src/cardfinder.cpp",
                    "src/ccnr_cms.cpp",
                    "src/ccnr.cpp",
+                   "src/probsat.cpp",
                    "src/clauseallocator.cpp",
                    "src/clausecleaner.cpp",
                    "src/cnf.cpp",
@@ -97,6 +98,7 @@ def gen_modules(version):
                    "src/solverconf.cpp",
                    "src/solver.cpp",
                    "src/str_impl_w_impl.cpp",
+                   "src/inprocsched.cpp",
                    "src/subsumeimplicit.cpp",
                    "src/subsumestrengthen.cpp",
                    "src/vardistgen.cpp",
@@ -29,30 +29,44 @@ THE SOFTWARE.
 
 using namespace CMSat;
 
-bool Solver::backbone_simpl(int64_t orig_max_confl, bool& finished)
+bool Solver::backbone_simpl(int64_t /*orig_max_confl*/, bool& finished)
 {
-    vector<int> cnf;
-    /* for(uint32_t i = 0; i < nVars(); i++) picosat_inc_max_var(picosat); */
+    // CadiBack takes the CNF as one flat vector. Size it exactly up front so
+    // it's built without re-allocation, and leave out what is already decided
+    // at level 0: satisfied clauses and false literals only cost memory there
+    assert(decisionLevel() == 0);
+    size_t sz = 0;
+    for(auto const& off: longIrredCls) sz += cl_alloc.ptr(off)->size()+1;
+    sz += binTri.irredBins*3;
 
+    vector<int> cnf;
+    cnf.reserve(sz);
     for(auto const& off: longIrredCls) {
         Clause* cl = cl_alloc.ptr(off);
+        if (satisfied(*cl)) continue;
         for(auto const& l1: *cl) {
+            if (value(l1) == l_False) continue;
             cnf.push_back(PICOLIT(l1));
         }
         cnf.push_back(0);
     }
     for(uint32_t i = 0; i < nVars()*2; i++) {
         Lit l1 = Lit::toLit(i);
+        if (value(l1) == l_True) continue;
         for(auto const& w: watches[l1]) {
             if (!w.isBin() || w.red()) continue;
             const Lit l2 = w.lit2();
             if (l1 > l2) continue;
+            if (value(l2) == l_True) continue;
 
-            cnf.push_back(PICOLIT(l1));
-            cnf.push_back(PICOLIT(l2));
+            if (value(l1) == l_Undef) cnf.push_back(PICOLIT(l1));
+            if (value(l2) == l_Undef) cnf.push_back(PICOLIT(l2));
             cnf.push_back(0);
         }
     }
+    assert(cnf.size() <= sz);
+    verb_print(2, "[backbone] CNF copy lits+terminators: " << cnf.size()
+        << " reserved: " << sz);
     vector<int> ret;
     int sat = CadiBack::doit(cnf, conf.verbosity, ret);
     if (sat) {
@@ -71,6 +85,119 @@ bool Solver::backbone_simpl(int64_t orig_max_confl, bool& finished)
     return sat != 20;
 }
 
+// Literals that are true in every model (under the assumptions), found
+// incrementally on this solver so learnt clauses carry over between checks.
+// The candidates are the literals of a model. Each check assumes one of them
+// false: a conflict proves it, a model drops it and every other candidate
+// that model falsifies.
+lbool Solver::find_backbone(
+    const vector<Lit>* assumps,
+    vector<Lit>& backbone,
+    backbone_cb_t cb,
+    void* cb_data,
+    const uint64_t max_confl_per_check,
+    const double max_time)
+{
+    const double my_time = cpuTime();
+    backbone.clear();
+    vector<Lit> check_assumps;
+    if (assumps) check_assumps = *assumps;
+    const size_t num_assumps = check_assumps.size();
+
+    // Every check is capped by the caller's own limits as well. solve()
+    // resets them, so they are put back once done
+    const uint64_t user_max_confl = conf.max_confl;
+    const double user_max_time = conf.maxTime;
+    auto set_check_limits = [&]() {
+        set_max_confl(max_confl_per_check);
+        conf.max_confl = std::min(conf.max_confl, user_max_confl);
+        conf.maxTime = std::min(max_time, user_max_time);
+    };
+    auto restore_limits = [&]() {
+        conf.max_confl = user_max_confl;
+        conf.maxTime = user_max_time;
+    };
+
+    set_check_limits();
+    lbool ret = solve_with_assumptions(assumps, false);
+    // solve() raises the interrupt flag when it returns. Lower it right away,
+    // so one raised by interrupt_asap() between two checks is still seen
+    if (ret != l_Undef) unset_must_interrupt_asap();
+    if (ret != l_True) {
+        restore_limits();
+        return ret;
+    }
+
+    bool stop = false;
+    auto report = [&](const Lit l) {
+        backbone.push_back(l);
+        if (cb && !cb(l, cb_data)) stop = true;
+    };
+
+    // Assumed and level-0 literals need no check
+    vector<uint8_t> assumed(nVarsOuter(), 0);
+    for(const Lit l: check_assumps) assumed[l.var()] = 1;
+    vector<Lit> cands;
+    for(uint32_t v = 0; v < nVarsOuter() && !stop; v++) {
+        if (model[v] == l_Undef) continue;
+        const Lit l = Lit(v, model[v] == l_False);
+        if (assumed[v] || value(map_outer_to_inter(v)) != l_Undef) report(l);
+        else cands.push_back(l);
+    }
+
+    uint64_t checks = 0;
+    uint64_t unknown = 0;
+    check_assumps.push_back(lit_Undef);
+    while(!cands.empty() && !stop) {
+        if (must_interrupt_asap()) {
+            stop = true;
+            break;
+        }
+        const Lit cand = cands.back();
+        check_assumps[num_assumps] = ~cand;
+
+        const uint64_t confl_before = get_stats().conflicts;
+        set_check_limits();
+        ret = solve_with_assumptions(&check_assumps, false);
+        checks++;
+
+        if (ret == l_True) {
+            unset_must_interrupt_asap();
+            size_t j = 0;
+            for(size_t i = 0; i < cands.size(); i++) {
+                if (model_value(cands[i]) == l_True) cands[j++] = cands[i];
+            }
+            cands.resize(j);
+            assert(cands.empty() || cands.back() != cand);
+        } else if (ret == l_False) {
+            unset_must_interrupt_asap();
+            cands.pop_back();
+            if (num_assumps == 0 && !frat->enabled()) {
+                vector<Lit> unit = {cand};
+                add_clause_outside(unit);
+            }
+            report(cand);
+        } else if (get_stats().conflicts - confl_before < max_confl_per_check) {
+            //Interrupted, out of time, or out of the caller's conflicts
+            stop = true;
+        } else {
+            //Only this check ran out, the next one starts afresh
+            unset_must_interrupt_asap();
+            cands.pop_back();
+            unknown++;
+        }
+    }
+    restore_limits();
+
+    verb_print(1, "[backbone] found: " << backbone.size()
+        << " unknown: " << (unknown + cands.size())
+        << " checks: " << checks
+        << " T: " << std::setprecision(2) << std::fixed << (cpuTime() - my_time));
+
+    if (stop || unknown > 0) return l_Undef;
+    return l_True;
+}
+
 void Solver::detach_and_free_all_irred_cls()
 {
     for(auto& ws: watches) {
@@ -53,8 +53,83 @@ ls_solver::ls_solver(const bool aspiration)
 }
 
 /**********************************build instance*******************************/
-bool ls_solver::make_space()
+void formula::clear()
 {
+    cl_lits.clear();
+    cl_start.clear();
+    num_clauses = 0;
+}
+
+void formula::add_clause(const vector<int>& lits)
+{
+    if (cl_start.empty()) cl_start.push_back(0);
+    for (int l: lits) cl_lits.push_back(lit(l));
+    cl_start.push_back(cl_lits.size());
+}
+
+void formula::build_occurrences()
+{
+    assert((int)cl_start.size() == num_clauses+1);
+
+    //count, then prefix sum, then fill -- keeps clauses in order per var
+    var_start.clear();
+    var_start.resize(num_vars+2, 0);
+    for (lit l: cl_lits) var_start[l.var_num+1]++;
+    for (int v = 1; v <= num_vars+1; v++) var_start[v] += var_start[v-1];
+
+    vector<uint32_t> at(var_start.begin(), var_start.end()-1);
+    var_occs.clear();
+    var_occs.resize(cl_lits.size(), occ(0, 0));
+    for (int c = 0; c < num_clauses; c++) {
+        for (lit l: lits_of(c)) {
+            var_occs[at[l.var_num]++] = occ(c, l.sense);
+        }
+    }
+}
+
+void formula::build_neighborhood(uint32_t verbosity)
+{
+    neighbor_vars.clear();
+    neighbor_start.clear();
+
+    uint64_t upper = 0;
+    for (int c = 0; c < num_clauses; c++) {
+        uint64_t sz = cl_start[c+1] - cl_start[c];
+        upper += sz*(sz-1);
+    }
+    if (upper > max_neighbor_entries) {
+        if (verbosity) {
+            cout << "c [ccnr] neighbourhood would be up to " << upper
+            << " entries, computing it on the fly" << endl;
+        }
+        return;
+    }
+
+    vector<uint8_t> neighbor_flag(num_vars+1, 0);
+    neighbor_start.resize(num_vars+2, 0);
+    for (int v = 1; v <= num_vars; ++v) {
+        const uint32_t start = neighbor_vars.size();
+        for (occ o: occs_of(v)) {
+            for (lit lc: lits_of(o.clause_num)) {
+                if (!neighbor_flag[lc.var_num] && (int)lc.var_num != v) {
+                    neighbor_flag[lc.var_num] = 1;
+                    neighbor_vars.push_back(lc.var_num);
+                }
+            }
+        }
+        for (uint32_t j = start; j < neighbor_vars.size(); ++j) {
+            neighbor_flag[neighbor_vars[j]] = 0;
+        }
+        neighbor_start[v+1] = neighbor_vars.size();
+    }
+    neighbor_vars.shrink_to_fit();
+}
+
+bool ls_solver::make_space(const formula* f)
+{
+    _f = f;
+    _num_vars = f->num_vars;
+    _num_clauses = f->num_clauses;
     if (0 == _num_vars || 0 == _num_clauses) {
         cout << "c [ccnr] The formula size is zero."
         "You may have forgotten to read the formula." << endl;
@@ -70,29 +145,6 @@ bool ls_solver::make_space()
     return true;
 }
 
-void ls_solver::build_neighborhood()
-{
-    vector<bool> neighbor_flag(_num_vars+1);
-    for (uint32_t j = 0; j < neighbor_flag.size(); ++j) {
-        neighbor_flag[j] = 0;
-    }
-    for (int v = 1; v <= _num_vars; ++v) {
-        variable *vp = &(_vars[v]);
-        for (lit lv: vp->literals) {
-            int c = lv.clause_num;
-            for (lit lc: _clauses[c].literals) {
-                if (!neighbor_flag[lc.var_num] && lc.var_num != v) {
-                    neighbor_flag[lc.var_num] = 1;
-                    vp->neighbor_var_nums.push_back(lc.var_num);
-                }
-            }
-        }
-        for (uint32_t j = 0; j < vp->neighbor_var_nums.size(); ++j) {
-            neighbor_flag[vp->neighbor_var_nums[j]] = 0;
-        }
-    }
-}
-
 /****************local search**********************************/
 //bool  *return value modified
 bool ls_solver::local_search(
@@ -100,6 +152,8 @@ bool ls_solver::local_search(
     , long long int _mems_limit
 ) {
     bool result = false;
+    _mems = 0;
+    flip_numbers = 0;
     _random_gen.seed(_random_seed);
     _best_found_cost = _num_clauses;
     _conflict_ct.clear();
@@ -119,6 +173,9 @@ bool ls_solver::local_search(
             if (_mems > _mems_limit) {
                 return result;
             }
+            if (_found && (_step & 0xff) == 0 && _found->load(std::memory_order_relaxed)) {
+                return result;
+            }
 
 
             if ((int)_unsat_clauses.size() < _best_found_cost) {
@@ -139,6 +196,7 @@ bool ls_solver::local_search(
 
 
             if (_best_found_cost == 0) {
+                if (_found) _found->store(true, std::memory_order_relaxed);
                 result = true;
                 break;
             }
@@ -196,7 +254,7 @@ void ls_solver::initialize(const vector<bool> *init_solution)
         _clauses[c].sat_var = -1;
         _clauses[c].weight = 1;
 
-        for (lit l: _clauses[c].literals) {
+        for (lit l: cl_lits(c)) {
             if (_solution[l.var_num] == l.sense) {
                 _clauses[c].sat_count++;
                 _clauses[c].sat_var = l.var_num;
@@ -217,11 +275,11 @@ void ls_solver::initialize_variable_datas()
     for (int v = 1; v <= _num_vars; v++) {
         vp = &(_vars[v]);
         vp->score = 0;
-        for (lit l: vp->literals) {
-            int c = l.clause_num;
+        for (occ o: var_occs(v)) {
+            int c = o.clause_num;
             if (0 == _clauses[c].sat_count) {
                 vp->score += _clauses[c].weight;
-            } else if (1 == _clauses[c].sat_count && l.sense == _solution[l.var_num]) {
+            } else if (1 == _clauses[c].sat_count && o.sense == _solution[v]) {
                 vp->score -= _clauses[c].weight;
             }
         }
@@ -301,10 +359,10 @@ int ls_solver::pick_var()
 
     /*focused random walk*/
     int c = _unsat_clauses[_random_gen.next(_unsat_clauses.size())];
-    clause *cp = &(_clauses[c]);
-    best_var = cp->literals[0].var_num;
-    for (size_t k = 1; k < cp->literals.size(); k++) {
-        int v = cp->literals[k].var_num;
+    const span<lit> lits = cl_lits(c);
+    best_var = lits[0].var_num;
+    for (uint32_t k = 1; k < lits.size(); k++) {
+        int v = lits[k].var_num;
         if (_vars[v].score > _vars[best_var].score) {
             best_var = v;
         } else if (_vars[v].score == _vars[best_var].score &&
@@ -319,18 +377,20 @@ int ls_solver::pick_var()
 void ls_solver::flip(int flipv)
 {
     _solution[flipv] = 1 - _solution[flipv];
+    flip_numbers++;
     int org_flipv_score = _vars[flipv].score;
-    _mems += _vars[flipv].literals.size();
+    const span<occ> occs = var_occs(flipv);
+    _mems += occs.size();
 
     // Go through each clause the literal is in and update status
-    for (lit l: _vars[flipv].literals) {
-        clause *cp = &(_clauses[l.clause_num]);
-        if (_solution[flipv] == l.sense) {
+    for (occ o: occs) {
+        clause *cp = &(_clauses[o.clause_num]);
+        if (_solution[flipv] == o.sense) {
             cp->sat_count++;
             if (1 == cp->sat_count) {
-                sat_a_clause(l.clause_num);
+                sat_a_clause(o.clause_num);
                 cp->sat_var = flipv;
-                for (lit lc: cp->literals) {
+                for (lit lc: cl_lits(o.clause_num)) {
                     _vars[lc.var_num].score -= cp->weight;
                 }
             } else if (2 == cp->sat_count) {
@@ -339,12 +399,12 @@ void ls_solver::flip(int flipv)
         } else {
             cp->sat_count--;
             if (0 == cp->sat_count) {
-                unsat_a_clause(l.clause_num);
-                for (lit lc: cp->literals) {
+                unsat_a_clause(o.clause_num);
+                for (lit lc: cl_lits(o.clause_num)) {
                     _vars[lc.var_num].score += cp->weight;
                 }
             } else if (1 == cp->sat_count) {
-                for (lit lc: cp->literals) {
+                for (lit lc: cl_lits(o.clause_num)) {
                     if (_solution[lc.var_num] == lc.sense) {
                         _vars[lc.var_num].score -= cp->weight;
                         cp->sat_var = lc.var_num;
@@ -379,13 +439,30 @@ void ls_solver::update_cc_after_flip(int flipv)
     }
 
     //update all flipv's neighbor's cc to be 1
-    _mems += vp->neighbor_var_nums.size()/4;
-    for (int v: vp->neighbor_var_nums) {
-        _vars[v].cc_value = 1;
-        if (_vars[v].score > 0 && !(_vars[v].is_in_ccd_vars)) {
-            _ccd_vars.push_back(v);
-            _vars[v].is_in_ccd_vars = 1;
+    if (!_f->neighbor_start.empty()) {
+        const uint32_t start = _f->neighbor_start[flipv];
+        const uint32_t end = _f->neighbor_start[flipv+1];
+        _mems += (end-start)/4;
+        for (uint32_t i = start; i < end; i++) {
+            set_neighbor_cc(_f->neighbor_vars[i]);
         }
+    } else {
+        //neighbours not stored, a var may be visited more than once
+        for (occ o: var_occs(flipv)) {
+            const span<lit> lits = cl_lits(o.clause_num);
+            _mems += lits.size()/4;
+            for (lit lc: lits) {
+                if ((int)lc.var_num != flipv) set_neighbor_cc(lc.var_num);
+            }
+        }
+    }
+}
+void ls_solver::set_neighbor_cc(int v)
+{
+    _vars[v].cc_value = 1;
+    if (_vars[v].score > 0 && !(_vars[v].is_in_ccd_vars)) {
+        _ccd_vars.push_back(v);
+        _vars[v].is_in_ccd_vars = 1;
     }
 }
 
@@ -401,7 +478,7 @@ void ls_solver::sat_a_clause(int the_clause)
     }
     _index_in_unsat_clauses[last_item] = index;
     //update unsat_appear and unsat_vars
-    for (lit l: _clauses[the_clause].literals) {
+    for (lit l: cl_lits(the_clause)) {
         _vars[l.var_num].unsat_appear--;
         if (0 == _vars[l.var_num].unsat_appear) {
             last_item = _unsat_vars.back();
@@ -419,7 +496,7 @@ void ls_solver::unsat_a_clause(int the_clause)
     _index_in_unsat_clauses[the_clause] = _unsat_clauses.size();
     _unsat_clauses.push_back(the_clause);
     //update unsat_appear and unsat_vars
-    for (lit l: _clauses[the_clause].literals) {
+    for (lit l: cl_lits(the_clause)) {
         _vars[l.var_num].unsat_appear++;
         if (1 == _vars[l.var_num].unsat_appear) {
             _index_in_unsat_vars[l.var_num] = _unsat_vars.size();
@@ -470,7 +547,7 @@ void ls_solver::smooth_clause_weights()
             _delta_total_clause_weight -= _num_clauses;
         }
         if (0 == cp->sat_count) {
-            for (lit l: cp->literals) {
+            for (lit l: cl_lits(c)) {
                 _vars[l.var_num].score += cp->weight;
             }
         } else if (1 == cp->sat_count) {
@@ -507,7 +584,7 @@ void ls_solver::print_solution(bool need_verify)
     if (need_verify) {
         for (int c = 0; c < _num_clauses; c++) {
             sat_flag = false;
-            for (lit l: _clauses[c].literals) {
+            for (lit l: cl_lits(c)) {
                 if (_solution[l.var_num] == l.sense) {
                     sat_flag = true;
                     break;
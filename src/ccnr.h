@@ -23,9 +23,11 @@ THE SOFTWARE.
 #ifndef CCNR_H
 #define CCNR_H
 
+#include <cstdlib>
 #include <cstdint>
 #include <string>
 #include <vector>
+#include <atomic>
 #include "ccnr_mersenne.h"
 
 using std::vector;
@@ -34,41 +36,38 @@ namespace CCNR {
 
 //--------------------------
 //functions in basis.h & basis.cpp
+
+//Entry of the clause->literals CSR array
 struct lit {
-    unsigned char sense : 1; //is 1 for true literals, 0 for false literals.
-    int clause_num : 31;     //clause num, begin with 0
-    int var_num;             //variable num, begin with 1
-    lit(int the_lit, int the_clause)
+    uint32_t sense : 1;    //is 1 for true literals, 0 for false literals.
+    uint32_t var_num : 31; //variable num, begin with 1
+    lit(int the_lit)
     {
         var_num = abs(the_lit);
-        clause_num = the_clause;
         sense = the_lit > 0 ? 1 : 0;
     }
-    struct lit &operator^=(const struct lit &l)
-    {
-        sense ^= l.sense;
-        clause_num ^= l.clause_num;
-        var_num ^= l.var_num;
-        return *this;
-    }
-    void reset(void)
-    {
-        sense = 0;
-        clause_num = 0;
-        var_num = 0;
-    }
-    bool operator==(const struct lit &l) const
-    {
-        return sense == l.sense && clause_num == l.clause_num && var_num == l.var_num;
-    }
-    bool operator!=(const struct lit &l) const
+};
+//Entry of the variable->occurrences CSR array
+struct occ {
+    uint32_t sense : 1;       //sense of the variable in the clause
+    uint32_t clause_num : 31; //clause num, begin with 0
+    occ(uint32_t the_clause, uint32_t the_sense)
     {
-        return !(*this == l);
+        clause_num = the_clause;
+        sense = the_sense;
     }
 };
+//Contiguous slice of one of the CSR arrays
+template<class T>
+struct span {
+    const T* b;
+    const T* e;
+    const T* begin() const { return b; }
+    const T* end() const { return e; }
+    uint32_t size() const { return e-b; }
+    const T& operator[](uint32_t i) const { return b[i]; }
+};
 struct variable {
-    vector<lit> literals;
-    vector<int> neighbor_var_nums;
     long long score;
     long long last_flip_step;
     int unsat_appear; //how many unsat clauses it appears in
@@ -76,12 +75,43 @@ struct variable {
     bool is_in_ccd_vars;
 };
 struct clause {
-    vector<lit> literals;
     int sat_count; //no. of satisfied literals
     int sat_var;
     long long weight;
 };
 
+//Clauses in CSR layout. Literals of clause c are
+//cl_lits[cl_start[c]..cl_start[c+1]), occurrences of var v are
+//var_occs[var_start[v]..var_start[v+1]). Read-only once built, so any
+//number of walkers can share it.
+struct formula {
+    vector<lit> cl_lits;
+    vector<uint32_t> cl_start;
+    vector<occ> var_occs;
+    vector<uint32_t> var_start;
+    int num_vars = 0;
+    int num_clauses = 0;
+
+    //Neighbours of var v are neighbor_vars[neighbor_start[v]..neighbor_start[v+1]).
+    //Not stored if there would be more than max_neighbor_entries, then
+    //they are walked through the occurrences on every flip instead
+    vector<uint32_t> neighbor_vars;
+    vector<uint32_t> neighbor_start;
+    static constexpr uint64_t max_neighbor_entries = 16ULL*1000ULL*1000ULL;
+
+    span<lit> lits_of(int c) const {
+        return {cl_lits.data()+cl_start[c], cl_lits.data()+cl_start[c+1]};
+    }
+    span<occ> occs_of(int v) const {
+        return {var_occs.data()+var_start[v], var_occs.data()+var_start[v+1]};
+    }
+
+    void clear();
+    void add_clause(const vector<int>& lits);
+    void build_occurrences();
+    void build_neighborhood(uint32_t verbosity);
+};
+
 //---------------------------
 //functions in mersenne.h & mersenne.cpp
 
@@ -103,11 +133,14 @@ class ls_solver
     }
     void set_verbosity(uint32_t verb);
 
-    //formula
+    //formula, shared, and this walker's per-var and per-clause state
+    const formula* _f = nullptr;
     vector<variable> _vars;
     vector<clause> _clauses;
     int _num_vars;
     int _num_clauses;
+    span<lit> cl_lits(int c) const { return _f->lits_of(c); }
+    span<occ> var_occs(int v) const { return _f->occs_of(v); }
 
     //data structure used
     vector<int> _conflict_ct;
@@ -122,12 +155,16 @@ class ls_solver
     vector<uint8_t> _best_solution;
 
     //functions for buiding data structure
-    bool make_space();
-    void build_neighborhood();
+    bool make_space(const formula* f);
+    void set_seed(int seed) { _random_seed = seed; }
+    //Set by the walker that satisfies the formula, the others stop then
+    void set_found_flag(std::atomic<bool>* found) { _found = found; }
     int get_cost() { return _unsat_clauses.size(); }
+    long long get_flips() const { return flip_numbers; }
 
     private:
     int _best_found_cost;
+    std::atomic<bool>* _found = nullptr;
     long long _mems = 0;
     long long _step;
     long long _max_steps;
@@ -162,6 +199,7 @@ class ls_solver
     int pick_var();
     void flip(int flipv);
     void update_cc_after_flip(int flipv);
+    void set_neighbor_cc(int v);
     void update_clause_weights();
     void smooth_clause_weights();
 
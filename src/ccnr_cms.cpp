@@ -29,7 +29,10 @@ THE SOFTWARE.
 #include "ccnr_cms.h"
 #include "solver.h"
 #include "ccnr.h"
+#include "probsat.h"
 #include "sqlstats.h"
+#include "datasync.h"
+#include <thread>
 //#define SLOW_DEBUG
 
 using namespace CMSat;
@@ -46,10 +49,13 @@ CMS_ccnr::CMS_ccnr(Solver* _solver) :
 CMS_ccnr::~CMS_ccnr()
 {
     delete ls_s;
+    for(auto w: walkers) delete w;
+    delete ps;
 }
 
 lbool CMS_ccnr::main(const uint32_t num_sls_called)
 {
+    phases_set = false;
     //It might not work well with few number of variables
     //rnovelty could also die/exit(-1), etc.
     if (solver->nVars() < 50 ||
@@ -75,17 +81,42 @@ lbool CMS_ccnr::main(const uint32_t num_sls_called)
         phases[i+1] = solver->varData[i].best_polarity;
     }
 
-    int res = ls_s->local_search(&phases, solver->conf.yalsat_max_mems*2*1000*1000);
-    lbool ret = deal_with_solution(res, num_sls_called);
+    const long long mems_limit = solver->conf.yalsat_max_mems*2*1000*1000;
+    const bool probsat = use_probsat();
+    int res;
+    long long flips;
+    if (probsat) {
+        if (!ps) ps = new CCNR::probsat_solver;
+        ps->set_verbosity(solver->conf.verbosity);
+        ps->make_space(&form);
+        res = ps->local_search(&phases, mems_limit);
+        solver->sls_best_cost = ps->get_best_cost();
+        flips = ps->get_flips();
+    } else {
+        if (solver->conf.sls_walkers <= 1) {
+            ls_s->make_space(&form);
+            res = ls_s->local_search(&phases, mems_limit);
+        } else {
+            res = run_walkers(phases, mems_limit);
+        }
+        solver->sls_best_cost = ls_s->get_best_cost();
+        flips = ls_s->get_flips();
+        for(const auto w: walkers) flips += w->get_flips();
+    }
+    lbool ret = deal_with_solution(res, num_sls_called, probsat);
 
     double time_used = cpuTime()-startTime;
     if (solver->conf.verbosity) {
-        cout << "c [ccnr] time: " << time_used << endl;
+        cout << "c [" << (probsat ? "probsat" : "ccnr") << "] time: " << time_used
+        << " flips: " << flips
+        << " flips/s: "
+        << (uint64_t)((double)flips/std::max(time_used, 0.001))
+        << endl;
     }
     if (solver->sqlStats) {
         solver->sqlStats->time_passed_min(
             solver
-            , "sls-ccnr"
+            , probsat ? "sls-probsat" : "sls-ccnr"
             , time_used
         );
     }
@@ -93,6 +124,98 @@ lbool CMS_ccnr::main(const uint32_t num_sls_called)
     return ret;
 }
 
+//"auto" picks probSAT for formulas of near-uniform clause length, such as
+//random k-SAT, where it's known to walk better than CCNR
+bool CMS_ccnr::use_probsat() const
+{
+    const string& which = solver->conf.which_sls;
+    if (which == "probsat") return true;
+    if (which != "auto") return false;
+
+    double mean = 0;
+    double var = 0;
+    double bin_ratio = 0;
+    bool have_stats = false;
+    #ifdef STATS_NEEDED
+    const SatZillaFeatures& feat = solver->last_solve_satzilla_feature;
+    if (feat.numClauses > 0) {
+        mean = feat.irred_cl_distrib.size_distr_mean;
+        var = feat.irred_cl_distrib.size_distr_var;
+        bin_ratio = feat.binary;
+        have_stats = true;
+    }
+    #endif
+    if (!have_stats) {
+        //Features are only calculated in stats builds, compute the same
+        //from the formula we are about to walk
+        uint64_t sum = 0;
+        uint64_t sum_sq = 0;
+        uint64_t num = 0;
+        uint64_t bins = 0;
+        for(int c = 0; c < form.num_clauses; c++) {
+            const uint64_t sz = form.cl_start[c+1] - form.cl_start[c];
+            if (sz <= 2) {bins++; continue;}
+            sum += sz;
+            sum_sq += sz*sz;
+            num++;
+        }
+        if (num == 0) return false;
+        mean = (double)sum/(double)num;
+        var = (double)sum_sq/(double)num - mean*mean;
+        bin_ratio = (double)bins/(double)form.num_clauses;
+    }
+    const bool uniform = mean >= 3.0 && var < 0.5 && bin_ratio < 0.1;
+    verb_print(2, "[sls] clause size mean: " << mean << " var: " << var
+        << " bin ratio: " << bin_ratio << " -> " << (uniform ? "probsat" : "ccnr"));
+
+    return uniform;
+}
+
+//Extra walkers each get a thread, share form, and differ in their seed and,
+//for every other one, in starting from a random assignment
+int CMS_ccnr::run_walkers(const vector<bool>& phases, const long long mems_limit)
+{
+    const uint32_t n = solver->conf.sls_walkers;
+    while (walkers.size() < n-1) {
+        walkers.push_back(new CCNR::ls_solver(solver->conf.sls_ccnr_asipire));
+    }
+
+    vector<int> res(n, 0);
+    vector<std::thread> thds;
+    std::atomic<bool> found(false);
+    for(uint32_t i = 1; i < n; i++) {
+        CCNR::ls_solver* w = walkers[i-1];
+        w->make_space(&form);
+        w->set_seed(1+i);
+        w->set_found_flag(&found);
+        const vector<bool>* init = (i % 2) ? nullptr : &phases;
+        thds.push_back(std::thread([w, init, mems_limit, &res, i]() {
+            res[i] = w->local_search(init, mems_limit);
+        }));
+    }
+    //ls_s may be a former walker swapped in below, give it back seed 1
+    ls_s->make_space(&form);
+    ls_s->set_seed(1);
+    ls_s->set_found_flag(&found);
+    res[0] = ls_s->local_search(&phases, mems_limit);
+    for(std::thread& t: thds) t.join();
+    ls_s->set_found_flag(nullptr);
+    for(auto w: walkers) w->set_found_flag(nullptr);
+
+    //Phases and bumping all come from ls_s, so make that the best walker
+    uint32_t best = 0;
+    for(uint32_t i = 1; i < n; i++) {
+        if (walkers[i-1]->get_best_cost() < ls_s->get_best_cost()) {
+            std::swap(ls_s, walkers[i-1]);
+            best = i;
+        }
+    }
+    verb_print(1, "[ccnr] walkers: " << n << " best: " << best
+        << " cost: " << ls_s->get_best_cost());
+
+    return res[best];
+}
+
 template<class T>
 CMS_ccnr::add_cl_ret CMS_ccnr::add_this_clause(const T& cl)
 {
@@ -132,22 +255,81 @@ CMS_ccnr::add_cl_ret CMS_ccnr::add_this_clause(const T& cl)
         return add_cl_ret::unsat;
     }
 
-    for(auto& lit: yals_lits) {
-        ls_s->_clauses[cl_num].literals.push_back(CCNR::lit(lit, cl_num));
-    }
+    form.add_clause(yals_lits);
     cl_num++;
 
     return add_cl_ret::added_cl;
 }
 
+static inline uint64_t lit_key(const Lit l)
+{
+    uint64_t x = l.toInt() + 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+//Order-independent key of every irredundant clause, sorted. Literal order
+//inside long clauses changes with propagation, so the key is a sum.
+void CMS_ccnr::get_cl_keys()
+{
+    cl_keys.clear();
+    for(size_t i2 = 0; i2 < solver->nVars()*2; i2++) {
+        Lit lit = Lit::toLit(i2);
+        for(const Watched& w: solver->watches[lit]) {
+            if (w.isBin() && !w.red() && lit < w.lit2()) {
+                cl_keys.push_back(lit_key(lit) + lit_key(w.lit2()));
+            }
+        }
+    }
+    for(ClOffset offs: solver->longIrredCls) {
+        const Clause* cl = solver->cl_alloc.ptr(offs);
+        uint64_t key = 0;
+        for(const Lit l: *cl) key += lit_key(l);
+        cl_keys.push_back(key);
+    }
+    std::sort(cl_keys.begin(), cl_keys.end());
+}
+
+uint64_t CMS_ccnr::get_assump_key() const
+{
+    uint64_t key = solver->assumptions.size();
+    for(const Lit l: solver->assumptions) key = key*31 + lit_key(l);
+    return key;
+}
+
 bool CMS_ccnr::init_problem()
 {
     if (solver->check_assumptions_contradict_foced_assignment()) return false;
     SLOW_DEBUG_DO(solver->check_stats());
 
-    ls_s->_num_vars = solver->nVars();
-    ls_s->_num_clauses = solver->longIrredCls.size() + solver->binTri.irredBins;
-    ls_s->make_space();
+    //Compare with what form was last built from. Zero-level assignments
+    //only ever get added, so as long as no clause appeared, every clause is
+    //a subset of one we had and the old neighbourhood is a superset of the
+    //new one -- that's good enough for configuration checking.
+    get_cl_keys();
+    const uint64_t assump_key = get_assump_key();
+    const bool same_vars = built
+        && last_nvars == solver->nVars()
+        && last_assump_key == assump_key;
+    if (same_vars
+        && last_trail_size == solver->trail_size()
+        && cl_keys == last_cl_keys
+    ) {
+        verb_print(2, "[ccnr] formula unchanged, re-using previous one");
+        return true;
+    }
+    bool keep_neighbors = same_vars
+        && std::includes(last_cl_keys.begin(), last_cl_keys.end(),
+                         cl_keys.begin(), cl_keys.end());
+    const size_t last_lits = form.cl_lits.size();
+
+    built = false;
+    cl_num = 0;
+    form.clear();
+    form.num_vars = solver->nVars();
+    form.cl_lits.reserve(solver->litStats.irredLits + solver->binTri.irredBins*2);
+    form.cl_start.reserve(solver->longIrredCls.size() + solver->binTri.irredBins + 1);
 
     vector<Lit> this_clause;
     for(size_t i2 = 0; i2 < solver->nVars()*2; i2++) {
@@ -174,28 +356,33 @@ bool CMS_ccnr::init_problem()
         }
     }
 
-    //Shrink the space if we have to
-    assert(ls_s->_num_clauses >= (int)cl_num);
-    ls_s->_num_clauses = (int)cl_num;
-    ls_s->make_space();
+    form.num_clauses = (int)cl_num;
+    if (!ls_s->make_space(&form)) return false;
+    form.build_occurrences();
 
-    for (int c=0; c < ls_s->_num_clauses; c++) {
-        for(CCNR::lit item: ls_s->_clauses[c].literals) {
-            int v = item.var_num;
-            ls_s->_vars[v].literals.push_back(item);
-        }
-    }
-    ls_s->build_neighborhood();
+    //Too loose after a large shrink, walking it would cost more than rebuilding
+    if (form.cl_lits.size()*2 < last_lits) keep_neighbors = false;
+    if (!keep_neighbors) form.build_neighborhood(solver->conf.verbosity);
+    verb_print(2, "[ccnr] re-built formula, cls: " << cl_num
+        << " kept neighbourhood: " << keep_neighbors);
+
+    std::swap(cl_keys, last_cl_keys);
+    last_assump_key = assump_key;
+    last_nvars = solver->nVars();
+    last_trail_size = solver->trail_size();
+    built = true;
 
     return true;
 }
 
 struct ClWeightSorter
 {
-    bool operator()(const CCNR::clause& a, const CCNR::clause& b)
+    ClWeightSorter(const vector<CCNR::clause>& _cls) : cls(_cls) {}
+    bool operator()(const uint32_t a, const uint32_t b) const
     {
-        return a.weight > b.weight;
+        return cls[a].weight > cls[b].weight;
     }
+    const vector<CCNR::clause>& cls;
 };
 
 struct VarAndVal {
@@ -220,15 +407,17 @@ vector<pair<uint32_t, double>> CMS_ccnr::get_bump_based_on_cls()
     SLOW_DEBUG_DO(for(const auto x: seen) assert(x == 0));
 
     vector<pair<uint32_t, double>> tobump_cl_var;
-    std::sort(ls_s->_clauses.begin(), ls_s->_clauses.end(), ClWeightSorter());
+    vector<uint32_t> cls_by_weight(ls_s->_num_clauses);
+    for(uint32_t i = 0; i < cls_by_weight.size(); i++) cls_by_weight[i] = i;
+    std::sort(cls_by_weight.begin(), cls_by_weight.end(), ClWeightSorter(ls_s->_clauses));
     uint32_t vars_bumped = 0;
     uint32_t individual_vars_bumped = 0;
-    for(const auto& c: ls_s->_clauses) {
+    for(const uint32_t c: cls_by_weight) {
         if (vars_bumped > solver->conf.sls_how_many_to_bump)
             break;
 
-        for(uint32_t i = 0; i < c.literals.size(); i++) {
-            uint32_t v = c.literals[i].var_num-1;
+        for(const CCNR::lit l: ls_s->cl_lits(c)) {
+            uint32_t v = l.var_num-1;
             if (v < solver->nVars() &&
                 solver->varData[v].removed == Removed::none &&
                 solver->value(v) == l_Undef &&
@@ -265,7 +454,8 @@ vector<pair<uint32_t, double>> CMS_ccnr::get_bump_based_on_var_scores()
     return tobump;
 }
 
-vector<pair<uint32_t, double>> CMS_ccnr::get_bump_based_on_conflict_ct()
+vector<pair<uint32_t, double>> CMS_ccnr::get_bump_based_on_conflict_ct(
+    const vector<int>& conflict_ct)
 {
     if (solver->conf.verbosity) {
         cout << "c [ccnr] bumping based on var unsat frequency: conflict_ct" << endl;
@@ -273,12 +463,12 @@ vector<pair<uint32_t, double>> CMS_ccnr::get_bump_based_on_conflict_ct()
 
     vector<pair<uint32_t, double>> tobump;
     int mymax = 0;
-    for(uint32_t i = 1; i < ls_s->_conflict_ct.size(); i++) {
-        mymax = std::max(mymax, ls_s->_conflict_ct[i]);
+    for(uint32_t i = 1; i < conflict_ct.size(); i++) {
+        mymax = std::max(mymax, conflict_ct[i]);
     }
 
-    for(uint32_t i = 1; i < ls_s->_conflict_ct.size(); i++) {
-        double val = ls_s->_conflict_ct[i];
+    for(uint32_t i = 1; i < conflict_ct.size(); i++) {
+        double val = conflict_ct[i];
         if (mymax > 0) {
             tobump.push_back(std::make_pair(i-1, (double)val/(double)mymax * 3.0));
         } else {
@@ -291,8 +481,11 @@ vector<pair<uint32_t, double>> CMS_ccnr::get_bump_based_on_conflict_ct()
     return tobump;
 }
 
-lbool CMS_ccnr::deal_with_solution(int res, const uint32_t num_sls_called)
+lbool CMS_ccnr::deal_with_solution(
+    int res, const uint32_t num_sls_called, const bool probsat)
 {
+    const vector<uint8_t>& best = probsat ? ps->_best_solution : ls_s->_best_solution;
+    const int best_cost = probsat ? ps->get_best_cost() : ls_s->get_best_cost();
     if (solver->conf.sls_get_phase || res) {
         if (solver->conf.verbosity) {
             cout
@@ -302,45 +495,52 @@ lbool CMS_ccnr::deal_with_solution(int res, const uint32_t num_sls_called)
         }
 
         for(size_t i = 0; i < solver->nVars(); i++) {
-            solver->varData[i].stable_polarity = ls_s->_best_solution[i+1];
+            solver->varData[i].stable_polarity = best[i+1];
             if (res) {
-                solver->varData[i].best_polarity = ls_s->_best_solution[i+1];
+                solver->varData[i].best_polarity = best[i+1];
             }
         }
+        phases_set = true;
+        solver->datasync->share_sls_phase(best, best_cost);
     }
 
     //Clause score sorting
+    //probSAT has no clause weights or scores, only how often vars got picked
     vector<pair<uint32_t, double>> tobump;
-    switch (solver->conf.sls_bump_type) {
-        case 1:
-            tobump = get_bump_based_on_cls();
-            break;
-        case 2:
-            assert(false && "Does not work, removed");
-            break;
-        case 3:
-            tobump = get_bump_based_on_var_scores();
-            break;
-        case 4:
-            tobump = get_bump_based_on_conflict_ct();
-            break;
-        case 5:
-            if (num_sls_called % 3 == 0) {
-                tobump = get_bump_based_on_conflict_ct();
-            } else {
-                tobump = get_bump_based_on_cls();
-            }
-            break;
-        case 6:
-            if (num_sls_called % 3 == 0) {
+    if (probsat) {
+        tobump = get_bump_based_on_conflict_ct(ps->_conflict_ct);
+    } else {
+        switch (solver->conf.sls_bump_type) {
+            case 1:
                 tobump = get_bump_based_on_cls();
-            } else {
-                tobump = get_bump_based_on_conflict_ct();
-            }
-            break;
-        default:
-            assert(false && "No such SLS bump type");
-            exit(-1);
+                break;
+            case 2:
+                assert(false && "Does not work, removed");
+                break;
+            case 3:
+                tobump = get_bump_based_on_var_scores();
+                break;
+            case 4:
+                tobump = get_bump_based_on_conflict_ct(ls_s->_conflict_ct);
+                break;
+            case 5:
+                if (num_sls_called % 3 == 0) {
+                    tobump = get_bump_based_on_conflict_ct(ls_s->_conflict_ct);
+                } else {
+                    tobump = get_bump_based_on_cls();
+                }
+                break;
+            case 6:
+                if (num_sls_called % 3 == 0) {
+                    tobump = get_bump_based_on_cls();
+                } else {
+                    tobump = get_bump_based_on_conflict_ct(ls_s->_conflict_ct);
+                }
+                break;
+            default:
+                assert(false && "No such SLS bump type");
+                exit(-1);
+        }
     }
 
 
@@ -27,9 +27,10 @@ THE SOFTWARE.
 #include <cstdio>
 #include <utility>
 #include "solvertypes.h"
+#include "ccnr.h"
 
 namespace CCNR {
-    class ls_solver;
+    class probsat_solver;
 }
 
 namespace CMSat {
@@ -41,6 +42,7 @@ using std::make_pair;
 class CMS_ccnr {
 public:
     lbool main(const uint32_t num_sls_called);
+    bool phases_set = false; //last main() wrote its best assignment to stable_polarity
     CMS_ccnr(Solver* _solver);
     ~CMS_ccnr();
 
@@ -58,10 +60,25 @@ private:
     void parse_parameters();
     void init_for_round();
     bool init_problem();
-    lbool deal_with_solution(int res, const uint32_t num_sls_called);
+    lbool deal_with_solution(int res, const uint32_t num_sls_called, const bool probsat);
+    CCNR::formula form;
     CCNR::ls_solver* ls_s = nullptr;
+    vector<CCNR::ls_solver*> walkers; //beyond ls_s, see conf.sls_walkers
+    int run_walkers(const vector<bool>& phases, const long long mems_limit);
+    CCNR::probsat_solver* ps = nullptr;
+    bool use_probsat() const;
     uint32_t cl_num = 0;
 
+    //What ls_s was last built from, so the next call only re-syncs the change
+    void get_cl_keys();
+    uint64_t get_assump_key() const;
+    vector<uint64_t> cl_keys;
+    vector<uint64_t> last_cl_keys;
+    uint64_t last_assump_key = 0;
+    uint32_t last_nvars = 0;
+    size_t last_trail_size = 0;
+    bool built = false;
+
     enum class add_cl_ret {added_cl, skipped_cl, unsat};
     template<class T>
     add_cl_ret add_this_clause(const T& cl);
@@ -73,7 +90,7 @@ private:
     vector<pair<uint32_t, double>> get_bump_based_on_cls();
     vector<pair<uint32_t, double>> get_bump_based_on_var_scores();
     vector<pair<uint32_t, double>> get_bump_based_on_var_flips();
-    vector<pair<uint32_t, double>> get_bump_based_on_conflict_ct();
+    vector<pair<uint32_t, double>> get_bump_based_on_conflict_ct(const vector<int>& conflict_ct);
 };
 
 }
@@ -23,6 +23,7 @@ THE SOFTWARE.
 #pragma once
 
 #include <atomic>
+#include <limits>
 #include <random>
 #include <gmpxx.h>
 
@@ -99,6 +100,7 @@ public:
     watch_array watches;
     vec<vec<GaussWatched>> gwatches;
     uint32_t num_sls_called = 0;
+    int64_t sls_best_cost = -1;
     vector<VarData> varData;
     branch branch_strategy = branch::vsids;
     string branch_strategy_str = "VSIDS";
@@ -173,6 +175,7 @@ public:
     LitStats litStats;
     int32_t clauseID = 0;
     int32_t clauseXID = 0;
+    int32_t clauseID_end = std::numeric_limits<int32_t>::max(); //IDs of this thread stay below, see setup_frat_threads()
     int64_t restartID = 1;
     SQLStats* sqlStats = nullptr;
     bool weighted = false;
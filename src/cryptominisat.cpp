@@ -25,6 +25,7 @@ THE SOFTWARE.
 #include "solver.h"
 #include "frat.h"
 #include "shareddata.h"
+#include "datasync.h"
 #include "solvertypesmini.h"
 
 #include <fstream>
@@ -64,6 +65,7 @@ namespace CMSat {
             for(Solver* this_s: solvers) {
                 delete this_s;
             }
+            delete proof_writer; //after the solvers, they flush into it
             if (must_interrupt_needs_delete) {
                 delete must_interrupt;
             }
@@ -77,6 +79,7 @@ namespace CMSat {
         //Mult-threaded data
         vector<Solver*> solvers;
         SharedData *shared_data = nullptr;
+        ProofWriter* proof_writer = nullptr;
         int which_solved = 0;
         std::atomic<bool>* must_interrupt;
         bool must_interrupt_needs_delete = false;
@@ -96,6 +99,13 @@ namespace CMSat {
         unsigned vars_to_add = 0;
         unsigned total_num_vars = 0;
         vector<Lit> cls_lits;
+        uint64_t cls_added = 0;
+        uint64_t next_stream_simp = 0;
+
+        //Progress reporting and solve_async()
+        progress_cb_t progress_cb = nullptr;
+        void* progress_cb_data = nullptr;
+        bool keep_interrupt = false; //interrupt_asap() may come before calc()
 
         //For single call setup
         uint32_t num_solve_simplify_calls = 0;
@@ -384,6 +394,45 @@ void update_config(SolverConf& conf, unsigned thread_num)
     }
 }
 
+//Proof buffers are handed to a background thread that does the actual
+//writing, so the solvers only block on I/O when all buffers are in flight
+static void setup_proof_writer(CMSatPrivateData* data, FILE* os)
+{
+    const uint32_t num_bufs = data->solvers[0]->conf.async_proof_bufs;
+    if (num_bufs == 0 || data->proof_writer != nullptr) return;
+
+    data->proof_writer = new ProofWriter(os, num_bufs);
+    for(Solver* s: data->solvers) s->frat->set_writer(data->proof_writer);
+}
+
+//Each thread buffers its own FRAT proof and flushes whole lines into the
+//common file. Clause IDs are split into disjoint ranges: one per thread, and
+//a last one for the clauses threads hand to each other via SharedData.
+static void setup_frat_threads(CMSatPrivateData* data)
+{
+    //Binaries keep their ID in the watchlist, which limits its size
+    const int64_t max_ID = std::min<int64_t>(
+        numeric_limits<int32_t>::max(), 1LL << (EFFECTIVELY_USEABLE_BITS-2));
+    const int32_t range = max_ID/(data->solvers.size()+1);
+    SharedData* shared = (SharedData*)data->shared_data;
+    FILE* os = data->solvers[0]->frat->getFile();
+    for(size_t i = 0; i < data->solvers.size(); i++) {
+        Solver& s = *data->solvers[i];
+        if (!s.frat->enabled()) {
+            s.conf.doBreakid = false;
+            s.add_frat(os);
+            s.conf.do_hyperbin_and_transred = true;
+        }
+        s.frat->set_file_mutex(&shared->frat_mutex);
+        s.frat->set_writer(data->proof_writer);
+        s.clauseID = (int32_t)i*range;
+        s.clauseXID = (int32_t)i*range;
+        s.clauseID_end = (int32_t)(i+1)*range;
+    }
+    shared->frat_pool_ID = (int32_t)data->solvers.size()*range;
+    shared->frat_pool_ID_end = (int32_t)(data->solvers.size()+1)*range;
+}
+
 DLL_PUBLIC void SATSolver::set_num_threads(unsigned num)
 {
     if (num <= 0) {
@@ -400,10 +449,14 @@ DLL_PUBLIC void SATSolver::set_num_threads(unsigned num)
         throw std::runtime_error(err);
     }
 
-    if (data->solvers[0]->frat->enabled() ||
-        data->solvers[0]->conf.simulate_frat
-    ) {
-        const char err[] = "ERROR: FRAT cannot be used in multi-threaded mode";
+    if (data->solvers[0]->conf.simulate_frat) {
+        const char err[] = "ERROR: FRAT simulation cannot be used in multi-threaded mode";
+        std::cerr << err << endl;
+        throw std::runtime_error(err);
+    }
+
+    if (data->solvers[0]->frat->incremental()) {
+        const char err[] = "ERROR: IDRUP cannot be used in multi-threaded mode";
         std::cerr << err << endl;
         throw std::runtime_error(err);
     }
@@ -440,6 +493,7 @@ DLL_PUBLIC void SATSolver::set_num_threads(unsigned num)
         data->solvers[i]->setConf(conf);
         data->solvers[i]->set_shared_data((SharedData*)data->shared_data);
     }
+    if (data->solvers[0]->frat->enabled()) setup_frat_threads(data);
 }
 
 struct OneThreadAddCls
@@ -695,6 +749,26 @@ DLL_PUBLIC bool SATSolver::add_red_clause(const vector< Lit >& lits) {
     return ret;
 }
 
+//Run the cheap part of simplification while the CNF is still being added.
+//Only done for single-threaded solving, where clauses go straight in.
+//The gap between runs doubles, so the total cost stays linear in the CNF size.
+static bool stream_simplify_if_needed(CMSatPrivateData* data, const uint64_t num_added)
+{
+    Solver& s = *data->solvers[0];
+    const uint64_t every_n = s.conf.stream_simplify_every_n_cls;
+    data->cls_added += num_added;
+    if (every_n == 0) return true;
+
+    if (data->next_stream_simp == 0) data->next_stream_simp = every_n;
+    if (data->cls_added < data->next_stream_simp) return true;
+    data->next_stream_simp = data->cls_added + std::max(every_n, data->cls_added);
+
+    if (!s.okay()) return false;
+    if (data->log) { (*data->log) << "c Solver::stream_simplify()" << endl; }
+    const lbool ret = s.simplify_with_assumptions(nullptr, &s.conf.simplify_schedule_stream);
+    return ret != l_False;
+}
+
 DLL_PUBLIC bool SATSolver::add_clause(const vector< Lit >& lits)
 {
     if (data->log) { (*data->log) << lits << " 0" << endl; }
@@ -715,11 +789,74 @@ DLL_PUBLIC bool SATSolver::add_clause(const vector< Lit >& lits)
 
         ret = data->solvers[0]->add_clause_outside(lits);
         data->cls++;
+        if (ret) ret = stream_simplify_if_needed(data, 1);
     }
 
     return ret;
 }
 
+template<class T>
+static bool add_clauses_flat(CMSatPrivateData* data, const T* lits, const size_t num_lits)
+{
+    if (data->log) {
+        for(size_t i = 0; i < num_lits; i++) {
+            if (is_flat_cl_end(lits[i])) (*data->log) << "0" << endl;
+            else (*data->log) << flat_to_lit(lits[i]) << " ";
+        }
+        if (num_lits > 0 && !is_flat_cl_end(lits[num_lits-1])) (*data->log) << "0" << endl;
+    }
+
+    bool ret = true;
+    if (data->solvers.size() > 1) {
+        //Same layout as the buffer, only the terminators become separators
+        bool new_cl = true;
+        for(size_t i = 0; i < num_lits; i++) {
+            if (data->cls_lits.size() + 2 > CACHE_SIZE && new_cl) {
+                ret &= actually_add_clauses_to_threads(data);
+            }
+            if (new_cl) {
+                data->cls_lits.push_back(lit_Undef);
+                new_cl = false;
+            }
+            if (is_flat_cl_end(lits[i])) new_cl = true;
+            else data->cls_lits.push_back(flat_to_lit(lits[i]));
+        }
+        return ret;
+    }
+
+    data->solvers[0]->new_vars(data->vars_to_add);
+    data->vars_to_add = 0;
+    ret = data->solvers[0]->add_clauses_outside(lits, num_lits);
+
+    uint64_t num_cls = 0;
+    for(size_t i = 0; i < num_lits; i++) num_cls += is_flat_cl_end(lits[i]);
+    if (num_lits > 0 && !is_flat_cl_end(lits[num_lits-1])) num_cls++;
+    data->cls += num_cls;
+    if (ret) ret = stream_simplify_if_needed(data, num_cls);
+
+    return ret;
+}
+
+DLL_PUBLIC bool SATSolver::add_clauses(const Lit* lits, const size_t num_lits)
+{
+    return add_clauses_flat(data, lits, num_lits);
+}
+
+DLL_PUBLIC bool SATSolver::add_clauses(const int32_t* lits, const size_t num_lits)
+{
+    const int64_t num_vars = nVars();
+    for(size_t i = 0; i < num_lits; i++) {
+        const int64_t var = std::abs((int64_t)lits[i]);
+        if (var > num_vars) {
+            const std::string err = "ERROR: Variable " + std::to_string(var)
+                + " inserted, but max var is " + std::to_string(num_vars);
+            std::cerr << err << endl;
+            throw std::runtime_error(err);
+        }
+    }
+    return add_clauses_flat(data, lits, num_lits);
+}
+
 void add_xor_clause_to_log(const std::vector<unsigned>& vars, bool rhs, std::ofstream* file)
 {
     if (vars.empty()) {
@@ -898,8 +1035,14 @@ lbool calc(
         exit(-1);
     }
 
-    //Reset the interrupt signal if it was set
-    data->must_interrupt->store(false, std::memory_order_relaxed);
+    //Reset the interrupt signal if it was set. solve_async() has already
+    //done it, and an interrupt since then must not be lost.
+    if (!data->keep_interrupt) {
+        data->must_interrupt->store(false, std::memory_order_relaxed);
+    }
+    data->keep_interrupt = false;
+    data->solvers[0]->progress_cb = data->progress_cb;
+    data->solvers[0]->progress_cb_data = data->progress_cb_data;
 
     //Set timeout information
     if (data->timeout != numeric_limits<double>::max()) {
@@ -954,6 +1097,12 @@ lbool calc(
     }
     lbool real_ret = *data_for_thread.ret;
 
+    //Pool clauses may only be finalized after every import of them
+    if (data->solvers[0]->frat->enabled()) {
+        for(Solver* s: data->solvers) s->frat->flush();
+        data->solvers[0]->datasync->write_final_frat_pool();
+    }
+
     //This does it for all of them, there is only one must-interrupt
     data_for_thread.solvers[0]->unset_must_interrupt_asap();
 
@@ -985,6 +1134,28 @@ DLL_PUBLIC lbool SATSolver::solve(const vector< Lit >* assumptions, bool only_sa
     return calc(assumptions, Todo::todo_solve, data, only_sampling_solution);
 }
 
+DLL_PUBLIC std::future<lbool> SATSolver::solve_async(const vector< Lit >* assumptions)
+{
+    //The caller's vector may be gone by the time the thread starts
+    const bool has_assumps = assumptions != nullptr;
+    vector<Lit> assumps;
+    if (has_assumps) {
+        assumps = *assumptions;
+    }
+
+    clear_interrupt_asap();
+    return std::async(std::launch::async,
+        [this, has_assumps, assumps = std::move(assumps)]() {
+            return solve(has_assumps ? &assumps : nullptr);
+        });
+}
+
+DLL_PUBLIC void SATSolver::set_progress_callback(progress_cb_t cb, void* user_data)
+{
+    data->progress_cb = cb;
+    data->progress_cb_data = user_data;
+}
+
 DLL_PUBLIC lbool SATSolver::simplify(const vector< Lit >* assumptions, const string* strategy)
 {
     if (data->promised_single_call
@@ -1128,18 +1299,18 @@ DLL_PUBLIC void SATSolver::set_find_xors(bool do_find_xors)
 
 DLL_PUBLIC void SATSolver::set_frat(FILE* os)
 {
-    if (data->solvers.size() > 1) {
-        std::cerr << "ERROR: FRAT cannot be used in multi-threaded mode" << endl;
-        exit(-1);
-    }
     if (nVars() > 0) {
         std::cerr << "ERROR: FRAT cannot be set after variables have been added" << endl;
         exit(-1);
     }
 
-    data->solvers[0]->conf.doBreakid = false;
-    data->solvers[0]->add_frat(os);
-    data->solvers[0]->conf.do_hyperbin_and_transred = true;
+    for (auto & solver : data->solvers) {
+        solver->conf.doBreakid = false;
+        solver->add_frat(os);
+        solver->conf.do_hyperbin_and_transred = true;
+    }
+    setup_proof_writer(data, os);
+    if (data->solvers.size() > 1) setup_frat_threads(data);
 }
 
 DLL_PUBLIC void SATSolver::set_idrup(FILE* os)
@@ -1155,6 +1326,7 @@ DLL_PUBLIC void SATSolver::set_idrup(FILE* os)
     data->solvers[0]->conf.doBreakid = false;
     data->solvers[0]->conf.doFindXors = false;
     data->solvers[0]->add_idrup(os);
+    setup_proof_writer(data, os);
     data->solvers[0]->conf.gaussconf.max_matrix_rows = 0;
     data->solvers[0]->conf.gaussconf.max_matrix_columns = 0;
     data->solvers[0]->conf.do_hyperbin_and_transred = true;
@@ -1165,6 +1337,12 @@ DLL_PUBLIC void SATSolver::interrupt_asap()
     data->must_interrupt->store(true, std::memory_order_relaxed);
 }
 
+DLL_PUBLIC void SATSolver::clear_interrupt_asap()
+{
+    data->must_interrupt->store(false, std::memory_order_relaxed);
+    data->keep_interrupt = true;
+}
+
 void DLL_PUBLIC SATSolver::add_in_partial_solving_stats()
 {
     data->solvers[data->which_solved]->add_in_partial_solving_stats();
@@ -1566,6 +1744,19 @@ DLL_PUBLIC void SATSolver::set_full_bve(int val)
     }
 }
 
+DLL_PUBLIC void SATSolver::set_stream_simplify(uint64_t every_n_cls)
+{
+    for (auto & solver : data->solvers) {
+        Solver& s = *solver;
+        s.conf.stream_simplify_every_n_cls = every_n_cls;
+    }
+    if (every_n_cls != 0 && data->solvers.size() > 1
+        && data->solvers[0]->conf.verbosity >= 1
+    ) {
+        cout << "c WARNING: stream simplification has no effect with more than one thread" << endl;
+    }
+}
+
 DLL_PUBLIC void SATSolver::set_sls(int val)
 {
     for (size_t i = 0; i < data->solvers.size(); ++i) {
@@ -1834,6 +2025,34 @@ DLL_PUBLIC bool SATSolver::backbone_simpl(int64_t max_confl, bool& finished)
     return s.backbone_simpl(max_confl, finished);
 }
 
+DLL_PUBLIC lbool SATSolver::find_backbone(
+    vector<Lit>& backbone,
+    const vector<Lit>* assumptions,
+    backbone_cb_t cb,
+    void* user_data,
+    uint64_t max_confl_per_check)
+{
+    Solver& s = *data->solvers[0];
+    if (!actually_add_clauses_to_threads(data)) {
+        backbone.clear();
+        return l_False;
+    }
+
+    double max_time = s.conf.maxTime;
+    if (data->timeout != numeric_limits<double>::max()) {
+        max_time = std::min(max_time, cpuTime() + data->timeout);
+    }
+    if (!data->keep_interrupt) {
+        data->must_interrupt->store(false, std::memory_order_relaxed);
+    }
+    data->keep_interrupt = false;
+
+    const lbool ret = s.find_backbone(assumptions, backbone, cb, user_data, max_confl_per_check, max_time);
+    data->which_solved = 0;
+    data->okay = s.okay();
+    return ret;
+}
+
 DLL_PUBLIC bool SATSolver::removed_var(uint32_t var) const{
     Solver& s = *data->solvers[0];
     actually_add_clauses_to_threads(data);
@@ -1851,6 +2070,11 @@ DLL_PUBLIC void SATSolver::set_oracle_removed_is_learnt(bool val) {
     s.conf.oracle_removed_is_learnt = val;
 }
 
+DLL_PUBLIC void SATSolver::set_oracle_threads(uint32_t threads) {
+    Solver& s = *data->solvers[0];
+    s.conf.oracle_threads = std::max(1U, threads);
+}
+
 // Weight stuff
 DLL_PUBLIC bool SATSolver::get_weighted() const {
     const Solver& s = *data->solvers[0];
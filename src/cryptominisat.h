@@ -30,6 +30,7 @@ THE SOFTWARE.
 #include <string>
 #include <limits>
 #include <cstdio>
+#include <future>
 #include "solvertypesmini.h"
 
 namespace CMSat {
@@ -61,6 +62,11 @@ namespace CMSat {
         unsigned nVars() const; //get number of variables inside the solver
         bool add_clause(const std::vector<Lit>& lits);
         bool add_red_clause(const std::vector<Lit>& lits);
+        //Add many clauses from one flat buffer, without a vector per clause.
+        //Each clause is terminated by lit_Undef, or by 0 in the DIMACS-style
+        //(1-based, negative means negated) variant. Variables must exist already.
+        bool add_clauses(const Lit* lits, const size_t num_lits);
+        bool add_clauses(const int32_t* lits, const size_t num_lits);
         bool add_xor_clause(const std::vector<unsigned>& vars, bool rhs);
         bool add_xor_clause(const std::vector<Lit>& lits, bool rhs = true);
         bool add_bnn_clause(
@@ -80,6 +86,16 @@ namespace CMSat {
         const std::vector<lbool>& get_model() const; //get model that satisfies the problem. Only makes sense if previous solve()/simplify() call was l_True
         const std::vector<Lit>& get_conflict() const; //get conflict in terms of the assumptions given in case the previous call to solve() was l_False
         bool okay() const; //the problem is still solveable, i.e. the empty clause hasn't been derived
+
+        //Run solve() on its own thread. Until the future is ready, only
+        //interrupt_asap() may be called on this object. interrupt_asap()
+        //makes the future return l_Undef and leaves the solver usable, even
+        //if called before the search has started.
+        std::future<lbool> solve_async(const std::vector<Lit>* assumptions = nullptr);
+        //Called at every restart of solve()/simplify(), from the thread doing
+        //the search. In multi-threaded mode, only the first thread reports.
+        //Pass nullptr to turn it off.
+        void set_progress_callback(progress_cb_t cb, void* user_data = nullptr);
         const std::vector<Lit>& get_decisions_reaching_model() const; //get decisions that lead to model. may NOT work, in case the decisions needed were internal, extended variables. exit(-1)'s in case of such a case. you MUST check decisions_reaching_computed().
 
         ////////////////////////////
@@ -140,6 +156,7 @@ namespace CMSat {
         void set_single_run(); //we promise to call solve() EXACTLY once
         void set_intree_probe(int val);
         void set_sls(int val);
+        void set_stream_simplify(uint64_t every_n_cls); //simplify while adding clauses, from N clauses on. 0 == off. Single-threaded only, XORs don't count
         void set_full_bve(int val);
         void set_full_bve_iter_ratio(double val);
         void set_scc(int val);
@@ -160,6 +177,7 @@ namespace CMSat {
         void set_orig_global_timeout_multiplier(const double mult);
         void set_oracle_get_learnts(bool val);
         void set_oracle_removed_is_learnt(bool val);
+        void set_oracle_threads(uint32_t threads); //oracle vivif/sparsify split the clauses among this many threads
         double get_orig_global_timeout_multiplier();
         bool minimize_clause(std::vector<Lit>& cl);
 
@@ -208,6 +226,7 @@ namespace CMSat {
         void set_idrup(FILE* os); //set idrup to ostream, e.g. stdout or a file
         void add_empty_cl_to_frat(); // allows to treat SAT as UNSAT and perform learning
         void interrupt_asap(); //call this asynchronously, and the solver will try to cleanly abort asap
+        void clear_interrupt_asap(); //clear a pending interrupt now. The next solve()/simplify() won't clear it again, so an interrupt_asap() from here on is not lost
         void add_in_partial_solving_stats(); //used only by Ctrl+C handler. Ignore.
 
         ////////////////////////////
@@ -235,6 +254,20 @@ namespace CMSat {
         lbool probe(Lit l, uint32_t& min_props);
         bool backbone_simpl(int64_t max_confl, bool& finished);
 
+        //Computes the literals true in every model, under the assumptions if
+        //given. Each one is appended to "backbone" and passed to "cb" as soon
+        //as it's proven. Returns l_False if UNSAT, l_True if the backbone is
+        //complete, and l_Undef if it was cut short by a check running out of
+        //max_confl_per_check conflicts, by the timeout, by interrupt_asap(),
+        //or by "cb" returning false. In that case "backbone" holds what was
+        //proven so far. Uses only the first thread.
+        lbool find_backbone(
+            std::vector<Lit>& backbone,
+            const std::vector<Lit>* assumptions = nullptr,
+            backbone_cb_t cb = nullptr,
+            void* user_data = nullptr,
+            uint64_t max_confl_per_check = std::numeric_limits<uint64_t>::max());
+
         //Given a set of literals to enqueue, returns:
         // 1) Whether they imply UNSAT. If "false": UNSAT
         // 2) into "out_implied" the set of literals they imply, including the literals themselves
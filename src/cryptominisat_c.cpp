@@ -92,6 +92,10 @@ extern "C"
         return self->add_clause(wrap(fromc(lits), num_lits));
     } NOEXCEPT_END
 
+    DLL_PUBLIC bool cmsat_add_clauses(SATSolver* self, const int32_t* lits, size_t num_lits) NOEXCEPT_START {
+        return self->add_clauses(lits, num_lits);
+    } NOEXCEPT_END
+
     DLL_PUBLIC bool cmsat_add_xor_clause(SATSolver* self, const unsigned* vars, size_t num_vars, bool rhs) NOEXCEPT_START {
         return self->add_xor_clause(wrap(vars, num_vars), rhs);
     } NOEXCEPT_END
@@ -62,6 +62,8 @@ CMS_DLL_PUBLIC void cmsat_free(SATSolver* s) NOEXCEPT;
 
 CMS_DLL_PUBLIC unsigned cmsat_nvars(const SATSolver* self) NOEXCEPT;
 CMS_DLL_PUBLIC bool cmsat_add_clause(SATSolver* self, const c_Lit* lits, size_t num_lits) NOEXCEPT;
+// DIMACS-style flat buffer: each clause terminated by 0, variables must exist
+CMS_DLL_PUBLIC bool cmsat_add_clauses(SATSolver* self, const int32_t* lits, size_t num_lits) NOEXCEPT;
 CMS_DLL_PUBLIC bool cmsat_add_xor_clause(SATSolver* self, const unsigned* vars, size_t num_vars, bool rhs) NOEXCEPT;
 CMS_DLL_PUBLIC void cmsat_new_vars(SATSolver* self, const size_t n) NOEXCEPT;
 
@@ -104,6 +104,12 @@ void DataSync::updateVars(
 ) {
 }
 
+bool DataSync::sync_due() const
+{
+    return sharedData != nullptr
+        && lastSyncConf + solver->conf.sync_every_confl < solver->sumConflicts;
+}
+
 bool DataSync::syncData()
 {
     if (!enabled()
@@ -115,11 +121,14 @@ bool DataSync::syncData()
 
     assert(sharedData != nullptr);
     assert(solver->decisionLevel() == 0);
+    if (solver->frat->enabled()) check_frat_ID_range();
 
     //SEND data
     bool ok;
     sharedData->unit_mutex.lock();
     ok = shareUnitData();
+    //Pool clauses must be in the proof before anyone can import them
+    if (solver->frat->enabled()) solver->frat->flush();
     sharedData->unit_mutex.unlock();
     if (!ok) {
         return false;
@@ -134,11 +143,16 @@ bool DataSync::syncData()
     extend_bins_if_needed();
     clear_set_binary_values();
     ok = shareBinData();
+    if (solver->frat->enabled()) solver->frat->flush();
     sharedData->bin_mutex.unlock();
     if (!ok) {
         return false;
     }
 
+    sharedData->sls_phase_mutex.lock();
+    sync_sls_phase();
+    sharedData->sls_phase_mutex.unlock();
+
     #ifdef USE_MPI
     if (solver->conf.is_mpi
         && solver->conf.thread_num == 0)
@@ -174,7 +188,6 @@ bool DataSync::syncData()
 bool DataSync::shareUnitData()
 {
     assert(solver->okay());
-    assert(!solver->frat->enabled());
 
     uint32_t thisGotUnitData = 0;
     uint32_t thisSentUnitData = 0;
@@ -198,6 +211,10 @@ bool DataSync::shareUnitData()
 
         if (thisVal != l_Undef && otherVal != l_Undef) {
             if (thisVal != otherVal) {
+                if (solver->frat->enabled() && solver->unsat_cl_ID == 0) {
+                    *solver->frat << add << ++solver->clauseID << fin;
+                    set_unsat_cl_id(solver->clauseID);
+                }
                 solver->ok = false;
                 return false;
             } else {
@@ -220,6 +237,13 @@ bool DataSync::shareUnitData()
 
         if (thisVal != l_Undef) {
             assert(otherVal == l_Undef);
+            if (solver->frat->enabled()) {
+                const Lit unit = solver->map_outer_to_inter(Lit(var, thisVal == l_False));
+                if (solver->varData[unit.var()].is_bva) continue;
+                int32_t ID = 0;
+                if (unit.var() == thisLit.var()) ID = solver->unit_cl_IDs[unit.var()];
+                add_to_frat_pool(vector<Lit>{unit}, ID);
+            }
             shared.value[var] = thisVal;
             thisSentUnitData++;
             continue;
@@ -241,6 +265,109 @@ bool DataSync::shareUnitData()
     return true;
 }
 
+//sol is indexed by internal var+1, as CCNR has it
+void DataSync::share_sls_phase(const vector<uint8_t>& sol, const int64_t cost)
+{
+    if (!enabled()) return;
+    assert(sol.size() >= solver->nVars()+1);
+
+    std::lock_guard<std::mutex> lock(sharedData->sls_phase_mutex);
+    SharedData& shared = *sharedData;
+    if (shared.sls_phase_cost != -1 && cost > shared.sls_phase_cost) return;
+
+    if (shared.sls_phase.size() < solver->nVarsOuter()) {
+        shared.sls_phase.resize(solver->nVarsOuter(), l_Undef);
+    }
+    for(uint32_t i = 0; i < solver->nVars(); i++) {
+        const uint32_t outer = solver->map_inter_to_outer(i);
+        shared.sls_phase[outer] = boolToLBool(sol[i+1]);
+    }
+    shared.sls_phase_cost = cost;
+    shared.sls_phase_gen++;
+    shared.sls_phase_thread = thread_id;
+    last_sls_phase_gen = shared.sls_phase_gen;
+    stats.sentSLSPhase++;
+}
+
+void DataSync::sync_sls_phase()
+{
+    SharedData& shared = *sharedData;
+    if (shared.sls_phase_gen == last_sls_phase_gen) return;
+    last_sls_phase_gen = shared.sls_phase_gen;
+    if (shared.sls_phase_thread == thread_id) return;
+
+    for(uint32_t i = 0; i < solver->nVars(); i++) {
+        const uint32_t outer = solver->map_inter_to_outer(i);
+        if (outer >= shared.sls_phase.size()
+            || shared.sls_phase[outer] == l_Undef
+        ) {
+            continue;
+        }
+        const bool val = shared.sls_phase[outer] == l_True;
+        solver->varData[i].stable_polarity = val;
+        if (shared.sls_phase_cost == 0) solver->varData[i].best_polarity = val;
+    }
+    stats.recvSLSPhase++;
+
+    verb_print(1, "[sync " << thread_id << "  ] got SLS phases of thread "
+        << shared.sls_phase_thread << " cost: " << shared.sls_phase_cost);
+}
+
+//Going past the end would reuse IDs of another thread (or of the pool),
+//silently corrupting the proof
+void DataSync::check_frat_ID_range() const
+{
+    if (solver->clauseID >= solver->clauseID_end
+        || solver->clauseXID >= solver->clauseID_end
+    ) {
+        std::cerr << "ERROR: thread " << thread_id
+        << " ran out of FRAT clause IDs, last ID: " << solver->clauseID
+        << " XID: " << solver->clauseXID
+        << " end of range: " << solver->clauseID_end << endl;
+        std::exit(-1);
+    }
+}
+
+//lits are INTERNAL, ID is the clause they are copied from (0 if unknown)
+void DataSync::add_to_frat_pool(const vector<Lit>& lits, const int32_t ID)
+{
+    const int32_t pool_ID = sharedData->frat_pool_ID++;
+    if (pool_ID >= sharedData->frat_pool_ID_end) {
+        std::cerr << "ERROR: ran out of FRAT clause IDs for clauses shared between threads" << endl;
+        std::exit(-1);
+    }
+    *solver->frat << add << pool_ID << lits;
+    if (ID != 0) *solver->frat << fratchain << ID;
+    *solver->frat << fin;
+
+    vector<Lit> outer_lits(lits);
+    for(Lit& l: outer_lits) l = solver->map_inter_to_outer(l);
+    std::lock_guard<std::mutex> lock(sharedData->frat_mutex);
+    sharedData->frat_pool.push_back(std::make_pair(pool_ID, outer_lits));
+}
+
+int32_t DataSync::find_bin_ID(const Lit lit1, const Lit lit2) const
+{
+    for(const Watched& w: solver->watches[lit1]) {
+        if (w.isBin() && w.lit2() == lit2) return w.get_ID();
+    }
+    return 0;
+}
+
+//Must only be called once all threads stopped and flushed their proofs
+void DataSync::write_final_frat_pool()
+{
+    if (!enabled() || !solver->frat->enabled()) return;
+
+    vector<Lit> lits;
+    for(const auto& p: sharedData->frat_pool) {
+        lits = p.second;
+        for(Lit& l: lits) l = solver->map_outer_to_inter(l);
+        *solver->frat << finalcl << p.first << lits << fin;
+    }
+    solver->frat->flush();
+}
+
 void CMSat::DataSync::signal_new_long_clause(const vector<Lit>& cl)
 {
     if (!enabled()) return;
@@ -312,8 +439,8 @@ bool DataSync::syncBinFromOthers(
             lits[0] = lit;
             lits[1] = otherLit;
 
-            //Don't add FRAT: it would add to the thread data, too
-            solver->add_clause_int(lits, true, nullptr, true, nullptr, false);
+            //With FRAT, this follows from the pool copy of the exporter
+            solver->add_clause_int(lits, true, nullptr, true, nullptr, solver->frat->enabled());
             if (!solver->okay()) {
                 goto end;
             }
@@ -333,7 +460,19 @@ bool DataSync::syncBinFromOthers(
 void DataSync::syncBinToOthers()
 {
     for(const std::pair<Lit, Lit>& bin: newBinClauses) {
-        add_bin_to_threads(bin.first, bin.second);
+        if (!solver->frat->enabled()) {
+            add_bin_to_threads(bin.first, bin.second);
+            continue;
+        }
+
+        //Only hand over binaries we still have, so the pool copy follows
+        //from our own clause
+        const Lit lit1 = solver->map_outer_to_inter(bin.first);
+        const Lit lit2 = solver->map_outer_to_inter(bin.second);
+        const int32_t ID = find_bin_ID(lit1, lit2);
+        if (ID != 0 && add_bin_to_threads(bin.first, bin.second)) {
+            add_to_frat_pool(vector<Lit>{lit1, lit2}, ID);
+        }
     }
 
     newBinClauses.clear();
@@ -46,18 +46,23 @@ class DataSync
         void new_var(const bool bva);
         void new_vars(const size_t n);
         bool syncData();
+        bool sync_due() const;
         void save_on_var_memory();
         void updateVars(
            const vector<uint32_t>& outer_to_inter
             , const vector<uint32_t>& inter_to_outer
         );
         void signal_new_long_clause(const vector<Lit>& clause);
+        void share_sls_phase(const vector<uint8_t>& sol, const int64_t cost);
+        void write_final_frat_pool();
 
         struct Stats {
             uint32_t sentUnitData = 0;
             uint32_t recvUnitData = 0;
             uint32_t sentBinData = 0;
             uint32_t recvBinData = 0;
+            uint32_t sentSLSPhase = 0;
+            uint32_t recvSLSPhase = 0;
         };
         const Stats& get_stats() const;
 
@@ -71,6 +76,11 @@ class DataSync
         void clear_set_binary_values();
         bool add_bin_to_threads(const Lit lit1, const Lit lit2);
         void signal_new_bin_clause(Lit lit1, Lit lit2);
+        void sync_sls_phase();
+        uint64_t last_sls_phase_gen = 0;
+        void add_to_frat_pool(const vector<Lit>& lits, const int32_t ID);
+        void check_frat_ID_range() const;
+        int32_t find_bin_ID(const Lit lit1, const Lit lit2) const;
 
         int thread_id = -1;
 
@@ -214,10 +214,15 @@ bool DistillerBin::try_distill_bin(
             confl = PropBy(ClOffset(0));
         } else if (solver->value(lit2) == l_False) {
             //Unit derived
-            solver->cancelUntil<false, true>(0);
             vector<Lit> x(1);
             x[0] = lit1;
-            solver->add_clause_int(x);
+            if (solver->frat->enabled()) {
+                const Lit bin[2] = {lit1, lit2};
+                solver->chain_from_trail(x, bin, 2, w.get_ID());
+            }
+            solver->cancelUntil<false, true>(0);
+            solver->add_clause_int(x, false, nullptr, true, nullptr, true,
+                lit_Undef, false, false, true);
             solver->detach_bin_clause(lit1, lit2, false, w.get_ID());
             (*solver->frat) << del << w.get_ID() << lit1 << lit2 << fin;
             runStats.numClShorten++;
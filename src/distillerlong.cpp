@@ -145,6 +145,21 @@ struct LitCountDescSort
     const vector<uint64_t>& lit_counts;
 };
 
+struct VivLitOrder
+{
+    VivLitOrder(const vector<uint64_t>& _lit_counts) :
+        lit_counts(_lit_counts)
+    {}
+
+    bool operator()(const Lit a, const Lit b) const {
+        if (lit_counts[a.toInt()] != lit_counts[b.toInt()])
+            return lit_counts[a.toInt()] > lit_counts[b.toInt()];
+        return a < b;
+    }
+
+    const vector<uint64_t>& lit_counts;
+};
+
 DistillerLong::DistillerLong(Solver* _solver) :
     solver(_solver)
 {}
@@ -441,11 +456,14 @@ ClOffset DistillerLong::try_distill_clause_and_return_new(
     VERBOSE_PRINT("Trying to distill clause:" << cl);
 
     uint32_t orig_size = cl.size();
+    const int32_t orig_ID = cl.stats.ID;
     uint32_t i = 0;
     uint32_t j = 0;
+    removed_lits.clear();
     for (uint32_t sz = cl.size(); i < sz; i++) {
         if (solver->value(cl[i]) == l_True) goto rem;
         if (solver->value(cl[i]) == l_Undef) cl[j++] = cl[i];
+        else removed_lits.push_back(cl[i]);
     }
     cl.resize(j);
     assert(cl.size() > 1); //this must have already been propagated
@@ -484,6 +502,7 @@ ClOffset DistillerLong::try_distill_clause_and_return_new(
         } else if (val == l_False) {
             // if we don't want to shorten, then don't remove literals
             if (only_remove) cl[j++] = cl[i];
+            else removed_lits.push_back(cl[i]);
         } else {
             assert(val == l_True);
             cl[j++] = cl[i];
@@ -563,16 +582,21 @@ ClOffset DistillerLong::try_distill_clause_and_return_new(
         }
     }*/
 
-    solver->cancelUntil<false, true>(0);
-    solver->detach_modified_clause(cl_lit1, cl_lit2, orig_size, &cl);
-    runStats.numLitsRem += orig_size - cl.size();
-    runStats.numClShorten++;
-
     //Make new clause
     if (!lits_set) {
         lits.resize(cl.size());
         std::copy(cl.begin(), cl.end(), lits.begin());
     }
+    if (solver->frat->enabled()) {
+        if (True_confl) solver->chain_from_trail(lits, confl, lits.back());
+        else if (!confl.isnullptr()) solver->chain_from_trail(lits, confl, solver->failBinLit);
+        else solver->chain_from_trail(lits, removed_lits.data(), removed_lits.size(), orig_ID);
+    }
+
+    solver->cancelUntil<false, true>(0);
+    solver->detach_modified_clause(cl_lit1, cl_lit2, orig_size, &cl);
+    runStats.numLitsRem += orig_size - cl.size();
+    runStats.numClShorten++;
 
     // we have to copy because the re-alloc can invalidate the data
     ClauseStats backup_stats(*stats);
@@ -583,7 +607,8 @@ ClOffset DistillerLong::try_distill_clause_and_return_new(
     std::stringstream ss2;
     ss2 << lits;
     *solver->frat << " new smaller cl: " << ss2.str().c_str() << "\n";
-    Clause *cl2 = solver->add_clause_int(lits, red, &backup_stats);
+    Clause *cl2 = solver->add_clause_int(lits, red, &backup_stats,
+        true, nullptr, true, lit_Undef, false, false, true);
     *solver->frat << findelay;
 
     if (cl2 != nullptr) {
@@ -600,6 +625,240 @@ ClOffset DistillerLong::try_distill_clause_and_return_new(
     }
 }
 
+// Vivification of the tier-0 and tier-1 learnt clauses. The literals of
+// every candidate are ordered by their number of occurrences among the
+// candidates, and the candidates lexicographically by these ordered literals.
+// Consecutive candidates then share a prefix of decisions, which is kept on
+// the trail instead of being re-propagated.
+bool DistillerLong::vivify_learnt(const int64_t max_props)
+{
+    assert(solver->ok);
+    assert(solver->decisionLevel() == 0);
+    frat_func_start();
+    const double my_time = cpuTime();
+    const size_t origTrailSize = solver->trail_size();
+    const Stats before = vivStats;
+    vivStats.numCalled++;
+
+    //Collect candidates, literals false at level 0 left out
+    lit_counts.clear();
+    lit_counts.resize(solver->nVars()*2, 0);
+    viv_cands.clear();
+    viv_lits.clear();
+    uint32_t already_tried = 0;
+    for(uint32_t tier = 0; tier < 2; tier++) {
+        auto& offs = solver->longRedCls[tier];
+        uint32_t j = 0;
+        for(const ClOffset off: offs) {
+            const Clause* cl = solver->cl_alloc.ptr(off);
+            already_tried += cl->distilled;
+            if (cl->distilled
+                || cl->stats.is_ternary_resolvent
+                || solver->satisfied(*cl)
+            ) {
+                offs[j++] = off;
+                continue;
+            }
+
+            VivCand c;
+            c.off = off;
+            c.start = viv_lits.size();
+            c.tier = tier;
+            for(const Lit l: *cl) {
+                if (solver->value(l) == l_False) continue;
+                viv_lits.push_back(l);
+                lit_counts[l.toInt()]++;
+            }
+            c.size = viv_lits.size() - c.start;
+            viv_cands.push_back(c);
+        }
+        offs.resize(j);
+    }
+    vivStats.potentialClauses += viv_cands.size();
+
+    //Every learnt clause has been tried, start over with the next budget
+    if (viv_cands.empty() && already_tried > 0) {
+        for(uint32_t tier = 0; tier < 2; tier++) {
+            for(const ClOffset off: solver->longRedCls[tier]) {
+                solver->cl_alloc.ptr(off)->distilled = 0;
+            }
+        }
+    }
+
+    const VivLitOrder order(lit_counts);
+    for(const auto& c: viv_cands) {
+        std::sort(viv_lits.begin()+c.start, viv_lits.begin()+c.start+c.size, order);
+    }
+    std::sort(viv_cands.begin(), viv_cands.end(),
+        [&](const VivCand& a, const VivCand& b) {
+            return std::lexicographical_compare(
+                viv_lits.begin()+a.start, viv_lits.begin()+a.start+a.size,
+                viv_lits.begin()+b.start, viv_lits.begin()+b.start+b.size,
+                order);
+        });
+
+    const uint64_t origBogoProps = solver->propStats.bogoProps;
+    bool time_out = false;
+    viv_decisions.clear();
+    for(const auto& c: viv_cands) {
+        if (!time_out
+            && ((int64_t)(solver->propStats.bogoProps - origBogoProps) > max_props
+                || solver->must_interrupt_asap())
+        ) {
+            vivStats.timeOut++;
+            time_out = true;
+        }
+
+        if (time_out || !solver->okay()) {
+            solver->longRedCls[c.tier].push_back(c.off);
+            continue;
+        }
+
+        const ClOffset new_off = vivify_one(c);
+        if (new_off != CL_OFFSET_MAX) solver->longRedCls[c.tier].push_back(new_off);
+    }
+    solver->cancelUntil<false, true>(0);
+    viv_decisions.clear();
+    lit_counts.clear();
+    lit_counts.shrink_to_fit();
+
+    const double time_used = cpuTime() - my_time;
+    const double time_remain = float_div(
+        max_props - ((int64_t)solver->propStats.bogoProps-(int64_t)origBogoProps),
+        max_props);
+    vivStats.time_used += time_used;
+    vivStats.zeroDepthAssigns += solver->trail_size() - origTrailSize;
+    verb_print(1, "[vivif-learnt]"
+        << " cls tried: " << vivStats.checkedClauses - before.checkedClauses
+        << "/" << viv_cands.size()
+        << " shortened: " << vivStats.numClShorten - before.numClShorten
+        << " lits-rem: " << vivStats.numLitsRem - before.numLitsRem
+        << " reused-levels: " << vivStats.reusedLevels - before.reusedLevels
+        << solver->conf.print_times(time_used, time_out, time_remain));
+    if (solver->sqlStats) {
+        solver->sqlStats->time_passed(
+            solver
+            , "vivif learnt"
+            , time_used
+            , time_out
+            , time_remain
+        );
+    }
+
+    frat_func_end();
+    return solver->okay();
+}
+
+// Number of decision levels that can stay on the trail for this candidate.
+// The decisions must be the negations of its first literals, and none of its
+// literals may have been propagated by the candidate itself.
+uint32_t DistillerLong::viv_reuse_level(const VivCand& c, const Clause& cl)
+{
+    assert(viv_decisions.size() == solver->decisionLevel());
+    const Lit* cand_lits = viv_lits.data() + c.start;
+    uint32_t level = 0;
+    for(uint32_t i = 0; i < c.size && level < viv_decisions.size(); i++) {
+        const Lit l = cand_lits[i];
+        if (solver->value(l) == l_False && solver->varData[l.var()].level == 0) continue;
+        if (viv_decisions[level] != ~l) break;
+        level++;
+    }
+
+    for(const Lit l: cl) {
+        if (solver->value(l) == l_Undef) continue;
+        const auto& vd = solver->varData[l.var()];
+        if (vd.level == 0 || vd.level > level) continue;
+        if (vd.reason.getType() == clause_t && vd.reason.get_offset() == c.off) {
+            level = vd.level - 1;
+        }
+    }
+    return level;
+}
+
+ClOffset DistillerLong::vivify_one(const VivCand& c)
+{
+    Clause& cl = *solver->cl_alloc.ptr(c.off);
+    const Lit* cand_lits = viv_lits.data() + c.start;
+    for(uint32_t i = 0; i < c.size; i++) {
+        const Lit l = cand_lits[i];
+        if (solver->value(l) == l_True && solver->varData[l.var()].level == 0) {
+            return c.off;
+        }
+    }
+
+    const uint32_t keep = viv_reuse_level(c, cl);
+    vivStats.reusedLevels += keep;
+    solver->cancelUntil<false, true>(keep);
+    viv_decisions.resize(keep);
+
+    vivStats.checkedClauses++;
+    cl.disabled = true;
+    lits.clear();
+    bool chain_set = false;
+    for(uint32_t i = 0; i < c.size; i++) {
+        const Lit l = cand_lits[i];
+        const lbool val = solver->value(l);
+        if (val == l_False) {
+            const auto& vd = solver->varData[l.var()];
+            //Our decision. Otherwise it's implied false by them, drop it
+            if (vd.level > 0 && vd.reason.isnullptr()) lits.push_back(l);
+            continue;
+        }
+        if (val == l_True) {
+            lits.push_back(l);
+            if (solver->frat->enabled()) {
+                solver->chain_from_trail(lits, solver->varData[l.var()].reason, l);
+                chain_set = true;
+            }
+            break;
+        }
+
+        solver->new_decision_level();
+        solver->enqueue<true>(~l);
+        viv_decisions.push_back(~l);
+        lits.push_back(l);
+        const PropBy confl = solver->propagate<true, true, true>();
+        if (!confl.isnullptr()) {
+            if (solver->frat->enabled()) {
+                solver->chain_from_trail(lits, confl, solver->failBinLit);
+                chain_set = true;
+            }
+            solver->cancelUntil<false, true>(solver->decisionLevel()-1);
+            viv_decisions.pop_back();
+            break;
+        }
+    }
+    cl.disabled = false;
+
+    //Couldn't shorten, keep the trail for the next candidate
+    if (lits.size() == cl.size()) {
+        cl.distilled = 1;
+        return c.off;
+    }
+
+    //The rest of the literals were propagated false
+    if (solver->frat->enabled() && !chain_set) {
+        solver->chain_from_trail(lits, cl.begin(), cl.size(), cl.stats.ID);
+    }
+    solver->cancelUntil<false, true>(0);
+    viv_decisions.clear();
+    vivStats.numClShorten++;
+    vivStats.numLitsRem += cl.size() - lits.size();
+
+    *solver->frat << deldelay << cl << fin;
+    solver->detachClause(cl, false);
+    ClauseStats backup_stats(cl.stats);
+    solver->free_cl(c.off, false);
+    Clause* cl2 = solver->add_clause_int(lits, true, &backup_stats,
+        true, nullptr, true, lit_Undef, false, false, true);
+    *solver->frat << findelay;
+
+    //Not marked, the next run may shorten it further
+    if (cl2 != nullptr) return solver->cl_alloc.get_offset(cl2);
+    //it became a bin/unit/zero
+    return CL_OFFSET_MAX;
+}
+
 DistillerLong::Stats& DistillerLong::Stats::operator+=(const Stats& other)
 {
     time_used += other.time_used;
@@ -611,6 +870,7 @@ DistillerLong::Stats& DistillerLong::Stats::operator+=(const Stats& other)
     potentialClauses += other.potentialClauses;
     numCalled += other.numCalled;
     clRemoved += other.clRemoved;
+    reusedLevels += other.reusedLevels;
 
     return *this;
 }
@@ -651,5 +911,7 @@ double DistillerLong::mem_used() const
 {
     double mem_used = sizeof(DistillerLong);
     mem_used += lits.size()*sizeof(Lit);
+    mem_used += viv_lits.capacity()*sizeof(Lit);
+    mem_used += viv_cands.capacity()*sizeof(VivCand);
     return mem_used;
 }
@@ -41,6 +41,7 @@ class DistillerLong {
     public:
         explicit DistillerLong(Solver* solver);
         bool distill(const bool red, bool only_rem_cl = false);
+        bool vivify_learnt(const int64_t max_props);
 
         struct Stats
         {
@@ -62,9 +63,11 @@ class DistillerLong {
             uint64_t potentialClauses = 0;
             uint64_t numCalled = 0;
             uint64_t clRemoved = 0;
+            uint64_t reusedLevels = 0;
         };
 
         const Stats& get_stats() const;
+        const Stats& get_viv_stats() const;
         double mem_used() const;
 
     private:
@@ -81,9 +84,24 @@ class DistillerLong {
         bool go_through_clauses(vector<ClOffset>& cls, const bool also_remove, const bool only_remove);
         Solver* solver;
 
+        //For vivify_learnt
+        struct VivCand {
+            ClOffset off;
+            uint32_t start;
+            uint32_t size;
+            uint32_t tier;
+        };
+        vector<VivCand> viv_cands;
+        vector<Lit> viv_lits;
+        vector<Lit> viv_decisions;
+        uint32_t viv_reuse_level(const VivCand& c, const Clause& cl);
+        ClOffset vivify_one(const VivCand& c);
+        Stats vivStats;
+
         //For distill
         vector<uint64_t> lit_counts;
         vector<Lit> lits;
+        vector<Lit> removed_lits; //for the FRAT hints
         uint64_t oldBogoProps;
         int64_t maxNumProps;
         int64_t orig_maxNumProps;
@@ -101,6 +119,11 @@ inline const DistillerLong::Stats& DistillerLong::get_stats() const
     return globalStats;
 }
 
+inline const DistillerLong::Stats& DistillerLong::get_viv_stats() const
+{
+    return vivStats;
+}
+
 } //end namespace
 
 #endif //_DISTILLERLONG_H_
@@ -378,6 +378,7 @@ void DistillerLongWithImpl::dump_stats_for_sub_str_all_cl_with_watch(
     const double time_used = cpuTime() - my_time;
     const bool time_out = timeAvailable < 0;
     const double time_remain = float_div(timeAvailable, orig_time_available);
+    solver->add_inproc_ticks((int64_t)orig_time_available, timeAvailable);
     tmpStats.numClSubsumed += watch_based_data.get_cl_subsumed();
     tmpStats.numLitsRem += watch_based_data.get_lits_rem();
     tmpStats.cpu_time = time_used;
@@ -19,7 +19,99 @@ THE SOFTWARE.
 ***********************************************/
 
 #include "frat.h"
+#include "time_mem.h"
+#include "solvertypes.h"
 
 namespace CMSat {
     void Frat::flush() {}
 }
+
+using namespace CMSat;
+
+ProofWriter::ProofWriter(FILE* _file, const uint32_t num_bufs) :
+    file(_file)
+{
+    assert(num_bufs > 0);
+    for(uint32_t i = 0; i < num_bufs; i++) {
+        free_bufs.push_back(new unsigned char[buf_size]);
+    }
+    thd = std::thread(&ProofWriter::run, this);
+}
+
+ProofWriter::~ProofWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock(mu);
+        stop = true;
+    }
+    cv_todo.notify_one();
+    thd.join();
+    assert(todo.empty());
+    fflush(file);
+    for(auto& buf: free_bufs) delete[] buf;
+}
+
+unsigned char* ProofWriter::swap(unsigned char* buf, const size_t len, const bool do_fflush)
+{
+    std::unique_lock<std::mutex> lock(mu);
+    todo.push_back(Chunk{buf, len, do_fflush});
+    cv_todo.notify_one();
+
+    if (free_bufs.empty()) {
+        num_stalls++;
+        const double my_time = real_time_sec();
+        cv_free.wait(lock, [this]{ return !free_bufs.empty(); });
+        stall_time += real_time_sec() - my_time;
+    }
+    unsigned char* ret = free_bufs.back();
+    free_bufs.pop_back();
+    return ret;
+}
+
+void ProofWriter::run()
+{
+    std::unique_lock<std::mutex> lock(mu);
+    while(true) {
+        cv_todo.wait(lock, [this]{ return stop || !todo.empty(); });
+        if (todo.empty()) {
+            assert(stop);
+            return;
+        }
+        const Chunk c = todo.front();
+        todo.pop_front();
+
+        lock.unlock();
+        const double my_time = real_time_sec();
+        fwrite(c.buf, sizeof(unsigned char), c.len, file);
+        if (c.do_fflush) fflush(file);
+        const double write_took = real_time_sec() - my_time;
+        lock.lock();
+
+        free_bufs.push_back(c.buf);
+        bytes_written += c.len;
+        num_chunks++;
+        write_time += write_took;
+        cv_free.notify_all();
+    }
+}
+
+void ProofWriter::print_stats() const
+{
+    std::lock_guard<std::mutex> lock(mu);
+    print_stats_line("c proof written"
+        , (double)bytes_written/(1024.0*1024.0)
+        , "MB in"
+        , num_chunks
+        , "chunks"
+    );
+    print_stats_line("c proof write time"
+        , write_time
+        , "s"
+    );
+    print_stats_line("c proof write stalls"
+        , num_stalls
+        , "times, waited"
+        , stall_time
+        , "s"
+    );
+}
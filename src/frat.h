@@ -23,7 +23,11 @@ THE SOFTWARE.
 #pragma once
 
 #include <vector>
+#include <deque>
 #include <iostream>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
 #include <stdio.h>
 
 #include "constants.h"
@@ -51,6 +55,50 @@ namespace CMSat {
   enum FratFlag{fin, deldelay, deldelayx, del, delx, findelay, add, addx, origcl, origclx, fratchain, finalcl, finalx, reloc, implyclfromx, implyxfromcls, weakencl, restorecl, assump, unsatcore, modelF};
   enum FratOutcome{satisfiable, unsatisfiable, unknown};
 
+// Writes the proof to its file from a background thread, so that solver
+// threads don't stall on slow storage. Proof files hand over full buffers,
+// which are written in the order they are handed over, and get an empty one
+// back from a fixed set. All threads of a SATSolver share one writer.
+class ProofWriter
+{
+public:
+    static constexpr size_t buf_size = 2 * 1024 * 1024;
+
+    ProofWriter(FILE* file, const uint32_t num_bufs);
+    ~ProofWriter();
+    ProofWriter(const ProofWriter&) = delete;
+    ProofWriter& operator=(const ProofWriter&) = delete;
+
+    // Queues buf[0..len) and returns an empty buffer of buf_size. Only
+    // blocks if all buffers are waiting to be written.
+    unsigned char* swap(unsigned char* buf, const size_t len, const bool do_fflush);
+    void print_stats() const;
+
+private:
+    struct Chunk {
+        unsigned char* buf;
+        size_t len;
+        bool do_fflush;
+    };
+    void run();
+
+    FILE* file;
+    std::thread thd;
+    mutable std::mutex mu;
+    std::condition_variable cv_todo;
+    std::condition_variable cv_free;
+    std::deque<Chunk> todo;
+    vector<unsigned char*> free_bufs;
+    bool stop = false;
+
+    //Stats
+    uint64_t bytes_written = 0;
+    uint64_t num_chunks = 0;
+    uint64_t num_stalls = 0;
+    double stall_time = 0;
+    double write_time = 0;
+};
+
 class Frat
 {
 public:
@@ -72,6 +120,9 @@ public:
     virtual Frat& operator<<(const FratFlag) { return *this; }
     virtual void setFile(FILE*) { }
     virtual FILE* getFile() { return nullptr; }
+    virtual void set_file_mutex(std::mutex*) { }
+    virtual void set_writer(ProofWriter*) { }
+    virtual void print_stats() const { }
     virtual void flush();
     virtual bool incremental() {return false;}
 
@@ -87,10 +138,10 @@ public:
     FratFile(vector<uint32_t>& _inter_to_outerMain) :
         inter_to_outerMain(_inter_to_outerMain)
     {
-        drup_buf = new unsigned char[2 * 1024 * 1024];
+        drup_buf = new unsigned char[ProofWriter::buf_size];
         buf_ptr = drup_buf;
         buf_len = 0;
-        memset(drup_buf, 0, 2 * 1024 * 1024);
+        memset(drup_buf, 0, ProofWriter::buf_size);
 
         del_buf = new unsigned char[2 * 1024 * 1024];
         del_ptr = del_buf;
@@ -107,6 +158,9 @@ public:
     virtual void set_sumconflicts_ptr(uint64_t* _sumConflicts) override { sumConflicts = _sumConflicts; }
     virtual void set_sqlstats_ptr(SQLStats* _sqlStats) override { sqlStats = _sqlStats; }
     virtual void setFile(FILE* _file) override { drup_file = _file; }
+    virtual void set_file_mutex(std::mutex* _file_mutex) override { file_mutex = _file_mutex; }
+    virtual void set_writer(ProofWriter* _writer) override { writer = _writer; }
+    virtual void print_stats() const override { if (writer) writer->print_stats(); }
     virtual bool something_delayed() override { return delete_filled; }
     virtual bool enabled() override { return true; }
 
@@ -120,8 +174,18 @@ public:
 
     virtual FILE* getFile() override { return drup_file; }
     virtual void flush() override { frat_flush(); }
+    // Only called at line ends. With several threads sharing the file, the
+    // buffer goes in as one chunk, via the writer or under file_mutex
     void frat_flush() {
-        fwrite(drup_buf, sizeof(unsigned char), buf_len, drup_file);
+        if (writer) {
+            if (buf_len == 0) return;
+            drup_buf = writer->swap(drup_buf, buf_len, false);
+        } else if (file_mutex) {
+            std::lock_guard<std::mutex> lock(*file_mutex);
+            fwrite(drup_buf, sizeof(unsigned char), buf_len, drup_file);
+        } else {
+            fwrite(drup_buf, sizeof(unsigned char), buf_len, drup_file);
+        }
         buf_ptr = drup_buf;
         buf_len = 0;
     }
@@ -428,6 +492,8 @@ private:
     bool adding = false;
     int32_t cl_id = 0;
     FILE* drup_file = nullptr;
+    std::mutex* file_mutex = nullptr;
+    ProofWriter* writer = nullptr;
     vector<uint32_t>& inter_to_outerMain;
     uint64_t* sumConflicts = nullptr;
     SQLStats* sqlStats = nullptr;
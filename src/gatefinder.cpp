@@ -84,6 +84,7 @@ void GateFinder::find_or_gates_and_update_stats()
     const double time_used = cpuTime() - my_time;
     const bool time_out = (numMaxGateFinder <= 0);
     const double time_remain = float_div(numMaxGateFinder, orig_numMaxGateFinder);
+    solver->add_inproc_ticks(orig_numMaxGateFinder, numMaxGateFinder);
     runStats.findGateTime = time_used;
     runStats.find_gate_timeout = time_out;
     if (solver->sqlStats) {
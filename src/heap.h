@@ -22,12 +22,18 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #define Glucose_Heap_h
 
 #include <iostream>
+#include <algorithm>
 #include "Vec.h"
 
 namespace CMSat {
 
 //=================================================================================================
 // A heap implementation with support for decrease/increase key.
+//
+// The heap is d-ary, d = 2^shift is set at runtime with set_arity(). A binary
+// heap (the default) is the classic layout. Wider heaps are shallower, so
+// bumping (percolateUp) touches fewer cache lines, while removeMin compares
+// more siblings, which are next to each other in memory.
 
 
 template<class Comp>
@@ -35,19 +41,16 @@ class Heap {
     Comp     lt;       // The heap is a minimum-heap with respect to this comparator
     vec<int> heap;     // Heap of integers
     vec<int> indices;  // Each integers position (index) in the Heap
+    int      shift = 1; // log2 of the arity
 
     // Index "traversal" functions
-    static inline int left  (int i)
+    inline int first_child(int i) const
     {
-        return i * 2 + 1;
+        return (i << shift) + 1;
     }
-    static inline int right (int i)
+    inline int parent(int i) const
     {
-        return (i + 1) * 2;
-    }
-    static inline int parent(int i)
-    {
-        return (i - 1) >> 1;
+        return (i - 1) >> shift;
     }
 
 
@@ -70,8 +73,13 @@ class Heap {
     void percolateDown(int i)
     {
         int x = heap[i];
-        while (left(i) < (int)heap.size()) {
-            int child = right(i) < (int)heap.size() && lt(heap[right(i)], heap[left(i)]) ? right(i) : left(i);
+        const int sz = heap.size();
+        while (first_child(i) < sz) {
+            int child = first_child(i);
+            const int end = std::min(child + (1 << shift), sz);
+            for(int c = child + 1; c < end; c++) {
+                if (lt(heap[c], heap[child])) child = c;
+            }
             if (!lt(heap[child], x)) {
                 break;
             }
@@ -87,6 +95,25 @@ class Heap {
 public:
     Heap(const Comp& c) : lt(c) { }
 
+    // Arity must be 2, 4 or 8. Elements already inside are re-heapified.
+    void set_arity(uint32_t arity)
+    {
+        assert(arity == 2 || arity == 4 || arity == 8);
+        int new_shift = 1;
+        while ((1U << new_shift) < arity) new_shift++;
+        if (new_shift == shift) return;
+
+        shift = new_shift;
+        for (int i = (int)heap.size() / 2 - 1; i >= 0; i--) {
+            percolateDown(i);
+        }
+    }
+
+    uint32_t arity() const
+    {
+        return 1U << shift;
+    }
+
     void print_heap() {
         std::cout << "heap:";
         for(auto x: heap) {
@@ -208,16 +235,11 @@ public:
         return mem;
     }
 
-    bool heap_property (uint32_t i) const {
-        return i >= heap.size()
-            || ( (i == 0 || !lt(heap[i], heap[parent(i)]))
-                  && heap_property( left(i)  )
-                  && heap_property( right(i) )
-            );
-    }
-
     bool heap_property() const {
-        return heap_property(0);
+        for (uint32_t i = 1; i < heap.size(); i++) {
+            if (lt(heap[i], heap[parent(i)])) return false;
+        }
+        return true;
     }
 
 };
@@ -57,10 +57,10 @@ public:
     IdrupFile(vector<uint32_t>& _interToOuterMain) :
         interToOuterMain(_interToOuterMain)
     {
-        drup_buf = new unsigned char[2 * 1024 * 1024];
+        drup_buf = new unsigned char[ProofWriter::buf_size];
         buf_ptr = drup_buf;
         buf_len = 0;
-        memset(drup_buf, 0, 2 * 1024 * 1024);
+        memset(drup_buf, 0, ProofWriter::buf_size);
 
         del_buf = new unsigned char[2 * 1024 * 1024];
         del_ptr = del_buf;
@@ -95,8 +95,12 @@ public:
     }
 
     void binDRUP_flush() {
-        fwrite(drup_buf, sizeof(unsigned char), buf_len, drup_file);
-        fflush (drup_file);
+        if (writer) {
+            drup_buf = writer->swap(drup_buf, buf_len, true);
+        } else {
+            fwrite(drup_buf, sizeof(unsigned char), buf_len, drup_file);
+            fflush (drup_file);
+        }
         buf_ptr = drup_buf;
         buf_len = 0;
     }
@@ -106,6 +110,16 @@ public:
         drup_file = _file;
     }
 
+    void set_writer(ProofWriter* _writer) override
+    {
+        writer = _writer;
+    }
+
+    void print_stats() const override
+    {
+        if (writer) writer->print_stats();
+    }
+
     bool something_delayed() override
     {
         return delete_filled;
@@ -503,6 +517,7 @@ private:
     int flushing = 0;
     int32_t cl_id = 0;
     FILE* drup_file = nullptr;
+    ProofWriter* writer = nullptr;
     vector<uint32_t>& interToOuterMain;
     uint64_t* sumConflicts = nullptr;
     SQLStats* sqlStats = NULL;
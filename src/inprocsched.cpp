@@ -0,0 +1,141 @@
+/******************************************
+Copyright (C) 2009-2020 Authors of CryptoMiniSat, see AUTHORS file
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#include "inprocsched.h"
+#include "solver.h"
+#include "time_mem.h"
+
+#include <iomanip>
+#include <algorithm>
+
+using namespace CMSat;
+using std::cout;
+using std::endl;
+
+//A removed variable is worth this many removed literals
+static const double var_weight = 10.0;
+static const double min_mult = 1.0/16.0;
+
+bool InprocSched::managed(const string& token)
+{
+    //Steps that are either mandatory or not about simplification
+    //are always executed as requested
+    if (token.substr(0,3) == "occ") return true;
+    return token == "scc-vrepl"
+        || token == "full-probe"
+        || token == "sub-impl"
+        || token == "intree-probe"
+        || token == "sub-str-cls-with-bin"
+        || token == "sub-cls-with-bin"
+        || token == "distill-bins"
+        || token == "distill-litrem"
+        || token == "distill-cls"
+        || token == "distill-cls-onlyrem"
+        || token == "str-impl";
+}
+
+double InprocSched::gain(const int64_t vars_rem, const int64_t lits_rem) const
+{
+    //Variable elimination usually adds literals, that is not held against it
+    return var_weight*std::max<int64_t>(vars_rem, 0) + std::max<int64_t>(lits_rem, 0);
+}
+
+bool InprocSched::begin(const string& token)
+{
+    assert(cur == nullptr);
+    if (!managed(token)) return true;
+
+    Tech& t = techs[token];
+    if (t.skip_left > 0) {
+        t.skip_left--;
+        t.skipped++;
+        verb_print(2, "[sched] skipping '" << token << "', it has not paid off lately");
+        return false;
+    }
+
+    t.calls++;
+    cur = &t;
+    cur_token = token;
+    start_time = cpuTime();
+    start_ticks = solver->ticks();
+    orig_multiplier = solver->conf.global_timeout_multiplier;
+    solver->conf.global_timeout_multiplier *= t.mult;
+    start_free_vars = solver->get_num_free_vars();
+    start_irred_lits = solver->litStats.irredLits + 2*solver->binTri.irredBins;
+    return true;
+}
+
+void InprocSched::end()
+{
+    if (cur == nullptr) return;
+    Tech& t = *cur;
+    cur = nullptr;
+    solver->conf.global_timeout_multiplier = orig_multiplier;
+
+    const double time_used = cpuTime() - start_time;
+    const uint64_t ticks_used = std::max<uint64_t>(solver->ticks() - start_ticks, 1000);
+    const int64_t vars_rem = (int64_t)start_free_vars - (int64_t)solver->get_num_free_vars();
+    const int64_t lits_rem = (int64_t)start_irred_lits
+        - (int64_t)(solver->litStats.irredLits + 2*solver->binTri.irredBins);
+    t.time += time_used;
+    t.ticks += ticks_used;
+    t.vars_rem += std::max<int64_t>(vars_rem, 0);
+    t.lits_rem += lits_rem;
+
+    const double g = gain(vars_rem, lits_rem);
+    sum_ticks += ticks_used;
+    sum_gain += g;
+
+    //Scale by how this step compares to the average productivity
+    if (g == 0) {
+        t.mult *= 0.5;
+    } else {
+        const double ref = sum_gain/(double)sum_ticks;
+        t.mult *= std::clamp((g/(double)ticks_used)/ref, 0.5, 2.0);
+    }
+    t.mult = std::clamp(t.mult, min_mult, solver->conf.adaptive_sched_max_mult);
+    if (t.mult <= min_mult) t.skip_left = solver->conf.adaptive_sched_retry;
+
+    verb_print(2, "[sched] '" << cur_token << "' vars-rem: " << vars_rem << " lits-rem: " << lits_rem
+        << " next mult: " << std::setprecision(3) << t.mult
+        << (t.skip_left ? " (skipping for a while)" : "")
+        << " ticks: " << print_value_kilo_mega(ticks_used)
+        << solver->conf.print_times(time_used));
+}
+
+void InprocSched::print_stats() const
+{
+    if (techs.empty()) return;
+    cout << "c ------- INPROCESSING SCHEDULER STATS ---------" << endl;
+    for(const auto& it: techs) {
+        const Tech& t = it.second;
+        cout << "c [sched] " << std::left << std::setw(28) << it.first << std::right
+        << " calls: " << std::setw(4) << t.calls
+        << " skipped: " << std::setw(4) << t.skipped
+        << " vars-rem: " << std::setw(7) << t.vars_rem
+        << " lits-rem: " << std::setw(9) << t.lits_rem
+        << " ticks: " << print_value_kilo_mega(t.ticks)
+        << " mult: " << std::fixed << std::setprecision(3) << t.mult
+        << " T: " << std::setprecision(2) << t.time
+        << endl;
+    }
+}
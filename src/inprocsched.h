@@ -0,0 +1,91 @@
+/******************************************
+Copyright (C) 2009-2020 Authors of CryptoMiniSat, see AUTHORS file
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <cstdint>
+#include "constants.h"
+
+using std::string;
+
+namespace CMSat {
+
+class Solver;
+
+/**
+@brief Decides how much effort each inprocessing step of the strategy string
+gets, based on how much it has paid off so far on this instance
+
+Every step is measured by the variables it removed (units, eliminated and
+replaced variables) and the irredundant literals it removed, against the
+ticks it used (see PropEngine::inproc_ticks), so the decisions do not depend
+on the machine's speed. Steps that are more productive than average get their time
+limits scaled up via conf.global_timeout_multiplier, steps that are less
+productive get them scaled down. A step that keeps producing nothing hits the
+lower bound and is then only retried every conf.adaptive_sched_retry calls.
+*/
+class InprocSched {
+public:
+    explicit InprocSched(Solver* _solver) :
+        solver(_solver)
+    {}
+
+    ///Returns false if the step must be skipped this time. Otherwise scales
+    ///the time limits and starts measuring. Must be followed by end()
+    bool begin(const string& token);
+    void end();
+    void print_stats() const;
+
+private:
+    Solver* solver;
+
+    struct Tech {
+        uint64_t calls = 0;
+        uint64_t skipped = 0;
+        uint32_t skip_left = 0;
+        double mult = 1.0;
+        double time = 0;
+        uint64_t ticks = 0;
+        uint64_t vars_rem = 0;
+        int64_t lits_rem = 0;
+    };
+    std::map<string, Tech> techs;
+    double gain(const int64_t vars_rem, const int64_t lits_rem) const;
+    static bool managed(const string& token);
+
+    //Data of the step currently being measured
+    Tech* cur = nullptr;
+    string cur_token;
+    double start_time;
+    uint64_t start_ticks;
+    double orig_multiplier;
+    uint64_t start_free_vars;
+    uint64_t start_irred_lits;
+
+    //Totals over all measured steps, the reference productivity
+    uint64_t sum_ticks = 0;
+    double sum_gain = 0;
+};
+
+}
@@ -214,7 +214,6 @@ void InTree::tree_look()
     assert(failed.empty());
     depth_failed.clear();
     depth_failed.push_back(false);
-    solver->propStats.clear();
 
     bool timeout = false;
     while(!queue.empty())
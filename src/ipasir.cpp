@@ -31,6 +31,9 @@ IN THE SOFTWARE.
 #include <complex>
 #include <cassert>
 #include <string.h>
+#include <climits>
+#include <cstdlib>
+#include <iostream>
 #include "constants.h"
 
 using std::vector;
@@ -109,6 +112,15 @@ void ensure_var_created(MySolver& s, Lit lit)
 }
 }
 
+//INT_MIN has no negation, so it can't name a variable
+static void check_lit(int lit)
+{
+    if (lit == INT_MIN) {
+        std::cerr << "ERROR: INT_MIN is not a valid IPASIR literal" << std::endl;
+        std::exit(-1);
+    }
+}
+
 /**
  * Add the given literal into the currently added clause
  * or finalize the clause with a 0.  Clauses added this way
@@ -132,12 +144,44 @@ DLL_PUBLIC void ipasir_add (void * solver, int lit_or_zero)
         s->solver->add_clause(s->clause);
         s->clause.clear();
     } else {
+        check_lit(lit_or_zero);
         Lit lit(std::abs(lit_or_zero)-1, lit_or_zero < 0);
         ensure_var_created(*s, lit);
         s->clause.push_back(lit);
     }
 }
 
+/**
+ * Non-standard extension: add many clauses at once from a flat
+ * buffer, each clause terminated by a 0. Avoids the per-literal
+ * call overhead of ipasir_add, but otherwise behaves the same.
+ */
+DLL_PUBLIC void ipasir_add_clauses (void * solver, const int * lits, size_t num_lits)
+{
+    MySolver* s = (MySolver*)solver;
+    for(size_t i = 0; i < num_lits; i++) check_lit(lits[i]);
+
+    //Finish the clause being added through ipasir_add
+    size_t start = 0;
+    if (!s->clause.empty()) {
+        for(; start < num_lits && lits[start] != 0; start++) ipasir_add(solver, lits[start]);
+        if (start == num_lits) return;
+        ipasir_add(solver, 0);
+        start++;
+    }
+
+    //Literals after the last 0 are left pending, as ipasir_add would
+    size_t end = num_lits;
+    while(end > start && lits[end-1] != 0) end--;
+
+    int max_var = 0;
+    for(size_t i = start; i < end; i++) max_var = std::max(max_var, std::abs(lits[i]));
+    if (max_var > 0) ensure_var_created(*s, Lit(max_var-1, false));
+    s->solver->add_clauses((const int32_t*)lits + start, end - start);
+
+    for(size_t i = end; i < num_lits; i++) ipasir_add(solver, lits[i]);
+}
+
 /**
  * Add an assumption for the next SAT search (the next call
  * of ipasir_solve). After calling ipasir_solve all the
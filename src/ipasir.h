@@ -77,6 +77,18 @@ void ipasir_release (void * solver);
  */
 void ipasir_add (void * solver, int lit_or_zero);
 
+/**
+ * Non-standard extension: add many clauses at once from a flat
+ * buffer, each clause terminated by a 0, exactly as if every
+ * element was passed to ipasir_add in turn. A clause started
+ * with ipasir_add is continued, and literals after the last 0
+ * start a clause that later calls finish.
+ *
+ * Required state: INPUT or SAT or UNSAT
+ * State after: INPUT
+ */
+void ipasir_add_clauses (void * solver, const int * lits, size_t num_lits);
+
 /**
  * Add an assumption for the next SAT search (the next call
  * of ipasir_solve). After calling ipasir_solve all the
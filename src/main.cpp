@@ -240,6 +240,10 @@ void Main::add_supported_options() {
         .action([&](const auto& a) {conf.orig_global_timeout_multiplier = std::atof(a.c_str());})
         .default_value(conf.orig_global_timeout_multiplier)
         .help("Time multiplier for all simplification cutoffs");
+    program.add_argument("--inproceffort")
+        .action([&](const auto& a) {conf.inprocess_effort_ratio = std::atof(a.c_str());})
+        .default_value(conf.inprocess_effort_ratio)
+        .help("Steer the simplification cutoffs so inprocessing gets this much effort (in ticks) per unit of search effort. 0 = only grow them by a fixed rate");
     program.add_argument("--nextm")
         .action([&](const auto& a) {conf.global_next_multiplier = std::atof(a.c_str());})
         .default_value(conf.global_next_multiplier)
@@ -255,6 +259,30 @@ void Main::add_supported_options() {
     program.add_argument("--polar")
         .default_value("auto")
         .help("{true,false,rnd,auto,stable} Selects polarity mode. 'true' -> selects only positive polarity when branching. 'false' -> selects only negative polarity when branching. 'auto' -> selects last polarity used (also called 'caching')");
+    program.add_argument("--rephase")
+        .action([&](const auto& a) {conf.do_rephase = std::atoi(a.c_str());})
+        .default_value(conf.do_rephase)
+        .help("With 'auto' polarity: use saved phases, and periodically reset them to original, inverted, best-trail, SLS walk or random phases");
+    program.add_argument("--rephasefirst")
+        .action([&](const auto& a) {conf.rephase_first = std::atoll(a.c_str());})
+        .default_value(conf.rephase_first)
+        .help("Conflicts before the first rephase");
+    program.add_argument("--rephaseinc")
+        .action([&](const auto& a) {conf.rephase_inc = std::atof(a.c_str());})
+        .default_value(conf.rephase_inc)
+        .help("Geometric increase of the number of conflicts between rephases");
+    program.add_argument("--modeswitch")
+        .action([&](const auto& a) {conf.do_mode_switch = std::atoi(a.c_str());})
+        .default_value(conf.do_mode_switch)
+        .help("With 'vmtf+vsids' branching and 'auto' restarts: alternate between focused mode (VMTF, glue restarts, saved phases) and stable mode (VSIDS, Luby restarts, target phases)");
+    program.add_argument("--modeswitchfirst")
+        .action([&](const auto& a) {conf.mode_switch_first = std::atoll(a.c_str());})
+        .default_value(conf.mode_switch_first)
+        .help("Conflicts in the first focused mode phase");
+    program.add_argument("--modeswitchinc")
+        .action([&](const auto& a) {conf.mode_switch_inc = std::atof(a.c_str());})
+        .default_value(conf.mode_switch_inc)
+        .help("Geometric increase of the length of the mode phases");
     program.add_argument("--scc")
         .action([&](const auto& a) {conf.doFindAndReplaceEqLits = std::atoi(a.c_str());})
         .default_value(conf.doFindAndReplaceEqLits)
@@ -374,6 +402,10 @@ void Main::add_supported_options() {
        .action([&](const auto& a) {conf.restart_first = std::atoi(a.c_str());})
        .default_value(conf.restart_first)
        .help("The size of the base restart");
+    program.add_argument("--rstfirststable")
+       .action([&](const auto& a) {conf.restart_first_stable = std::atoi(a.c_str());})
+       .default_value(conf.restart_first_stable)
+       .help("The size of the base Luby restart in stable search mode");
     program.add_argument("--gluehist")
         .action([&](const auto& a) {conf.shortTermHistorySize = std::atoi(a.c_str());})
         .default_value(conf.shortTermHistorySize)
@@ -395,6 +427,10 @@ void Main::add_supported_options() {
         .action([&](const auto& a) {conf.do_blocking_restart = std::atoi(a.c_str());})
         .default_value(conf.do_blocking_restart)
         .help("Do blocking restart for glues");
+    program.add_argument("--reusetrail")
+        .action([&](const auto& a) {conf.do_reuse_trail = std::atoi(a.c_str());})
+        .default_value(conf.do_reuse_trail)
+        .help("On restart, keep the decision levels whose decisions rank above the next decision candidate, instead of backtracking to level 0");
 
     /* po::options_description reduceDBOptions("Redundant clause options"); */
     program.add_argument("--gluecut0")
@@ -433,6 +469,10 @@ void Main::add_supported_options() {
         .action([&](const auto& a) {conf.branch_strategy_setup = a;})
         .default_value(conf.branch_strategy_setup)
         .help("Branch strategy string that switches between different branch strategies while solving e.g. 'vsids1+vsids2'");
+    program.add_argument("--vsidsheap")
+        .action([&](const auto& a) {conf.vsids_heap_arity = std::atoi(a.c_str());})
+        .default_value(conf.vsids_heap_arity)
+        .help("Arity of the VSIDS decision heap: 2, 4 or 8");
 
     program.add_argument("--nobansol")
         .flag()
@@ -484,7 +524,7 @@ void Main::add_supported_options() {
     program.add_argument("--slstype")
         .action([&](const auto& a) {conf.which_sls = a;})
         .default_value(conf.which_sls)
-        .help("Which SLS to run. Allowed values: walksat, yalsat, ccnr, ccnr_yalsat");
+        .help("Which SLS to run. Allowed values: ccnr, probsat, auto (probsat for uniform clause lengths, ccnr otherwise). walksat, yalsat and ccnr_yalsat all run ccnr");
     program.add_argument("--slsmaxmem")
         .action([&](const auto& a) {conf.sls_memoutMB = std::atoi(a.c_str());})
         .default_value(conf.sls_memoutMB)
@@ -521,6 +561,10 @@ void Main::add_supported_options() {
         .action([&](const auto& a) {conf.sls_bump_type = std::atoi(a.c_str());})
         .default_value(conf.sls_bump_type)
         .help("How to calculate what variable to bump. 1 = clause-based, 2 = var-flip-based, 3 = var-score-based");
+    program.add_argument("--slswalkers")
+        .action([&](const auto& a) {conf.sls_walkers = std::atoi(a.c_str());})
+        .default_value(conf.sls_walkers)
+        .help("Number of CCNR walkers to run in parallel, each in its own thread, sharing the clauses. Best assignment is shared with all CDCL threads");
 
     /* po::options_description probeOptions("Probing options"); */
     program.add_argument("--transred")
@@ -561,6 +605,18 @@ void Main::add_supported_options() {
         .action([&](const auto& a) {conf.max_num_simplify_per_solve_call = std::atoi(a.c_str());})
         .default_value(conf.max_num_simplify_per_solve_call)
         .help("Maximum number of simplifiactions to perform for every solve() call. After this, no more inprocessing will take place.");
+    program.add_argument("--adaptsched")
+        .action([&](const auto& a) {conf.adaptive_sched = std::atoi(a.c_str());})
+        .default_value(conf.adaptive_sched)
+        .help("Scale the time limits of the simplification schedule's steps by how much they have paid off so far, skip the ones that stopped paying off");
+    program.add_argument("--adaptschedmaxmult")
+        .action([&](const auto& a) {conf.adaptive_sched_max_mult = std::atof(a.c_str());})
+        .default_value(conf.adaptive_sched_max_mult)
+        .help("Maximum time limit multiplier the adaptive schedule gives to a step");
+    program.add_argument("--adaptschedretry")
+        .action([&](const auto& a) {conf.adaptive_sched_retry = std::atoi(a.c_str());})
+        .default_value(conf.adaptive_sched_retry)
+        .help("A step that has stopped paying off is retried after it has been skipped this many times");
 
     program.add_argument("--schedule")
         .action([&](const auto& a) {conf.simplify_schedule_nonstartup = a;})
@@ -568,6 +624,13 @@ void Main::add_supported_options() {
     program.add_argument("--preschedule")
         .action([&](const auto& a) {conf.simplify_schedule_startup = a;})
         .help("Schedule for simplification at startup");
+    program.add_argument("--streamsimp")
+        .action([&](const auto& a) {conf.stream_simplify_every_n_cls = std::atoll(a.c_str());})
+        .default_value(conf.stream_simplify_every_n_cls)
+        .help("Simplify after N clauses have been read, then every time the number of clauses read doubles, while the CNF is still being read. 0 = never");
+    program.add_argument("--streamschedule")
+        .action([&](const auto& a) {conf.simplify_schedule_stream = a;})
+        .help("Schedule for simplification while the CNF is still being read");
     program.add_argument("--occsimp")
         .action([&](const auto& a) {conf.perform_occur_based_simp = std::atoi(a.c_str());})
         .default_value(conf.perform_occur_based_simp)
@@ -657,7 +720,7 @@ void Main::add_supported_options() {
     program.add_argument("--bva")
         .action([&](const auto& a) {conf.do_bva = std::atoi(a.c_str());})
         .default_value(conf.do_bva)
-        .help("Perform bounded variable addition");
+        .help("Perform bounded variable addition. No longer supported, ignored");
     program.add_argument("--bvaeveryn")
         .action([&](const auto& a) {conf.bva_every_n = std::atoi(a.c_str());})
         .default_value(conf.bva_every_n)
@@ -752,6 +815,10 @@ void Main::add_supported_options() {
         .action([&](const auto& a) {conf.doMinimRedMoreMore = std::atoi(a.c_str());})
         .default_value(conf.doMinimRedMoreMore)
         .help("Perform even stronger minimisation at conflict gen.");
+    program.add_argument("--shrink")
+        .action([&](const auto& a) {conf.doShrinkMinim = std::atoi(a.c_str());})
+        .default_value(conf.doShrinkMinim)
+        .help("Shrink learnt clauses: replace the literals of each decision level with that level's UIP where possible");
     program.add_argument("--moremorealways")
         .action([&](const auto& a) {conf.doAlwaysFMinim = std::atoi(a.c_str());})
         .default_value(conf.doAlwaysFMinim)
@@ -776,6 +843,10 @@ void Main::add_supported_options() {
         .action([&](const auto& a) {conf.diff_declev_for_chrono = std::atoi(a.c_str());})
         .default_value(conf.diff_declev_for_chrono)
         .help("Difference in decision level is more than this, perform chonological backtracking instead of non-chronological backtracking. Giving -1 means it is never turned on (overrides '--confltochrono -1' in this case).");
+    program.add_argument("--confltochrono")
+        .action([&](const auto& a) {conf.confl_to_chrono = std::atoll(a.c_str());})
+        .default_value(conf.confl_to_chrono)
+        .help("Only perform chronological backtracking after this many conflicts. Giving -1 means it is never turned on.");
 
 #ifdef USE_SQLITE3
     /* po::options_description sqlOptions("SQL options"); */
@@ -869,6 +940,22 @@ void Main::add_supported_options() {
         .action([&](const auto& a) {conf.distill_sort = std::atoi(a.c_str());})
         .default_value(conf.distill_sort)
         .help("Distill sorting type");
+    program.add_argument("--oraclethreads")
+        .action([&](const auto& a) {conf.oracle_threads = std::max(1, std::atoi(a.c_str()));})
+        .default_value(conf.oracle_threads)
+        .help("Number of threads oracle-based vivification and sparsification split the clauses among");
+    program.add_argument("--vivif")
+        .action([&](const auto& a) {conf.do_vivify_learnt = std::atoi(a.c_str());})
+        .default_value(conf.do_vivify_learnt)
+        .help("Regularly vivify tier-0 and tier-1 learnt clauses, reusing the trail between clauses that share literals");
+    program.add_argument("--viveff")
+        .action([&](const auto& a) {conf.vivify_learnt_effort = std::atof(a.c_str());})
+        .default_value(conf.vivify_learnt_effort)
+        .help("Vivification budget, relative to the bogoprops spent since the previous vivification");
+    program.add_argument("--viveveryn")
+        .action([&](const auto& a) {conf.vivify_learnt_every = std::atoi(a.c_str());})
+        .default_value(conf.vivify_learnt_every)
+        .help("Vivify learnt clauses every N conflicts");
     ;
 
     /* po::options_description mem_save_opts("Memory saving options"); */
@@ -944,6 +1031,10 @@ void Main::add_supported_options() {
         .action([&](const auto& a) {conf.idrup = std::atoi(a.c_str());})
         .default_value(conf.idrup)
         .help("idrup");
+    program.add_argument("--proofbufs")
+        .action([&](const auto& a) {conf.async_proof_bufs = std::atoi(a.c_str());})
+        .default_value(conf.async_proof_bufs)
+        .help("Number of 2MB buffers handed to a background proof writer thread. 0 = write the proof synchronously");
     program.add_argument("--onlysampling")
         .flag()
         .action([&](const auto&) {only_sampl_solution = true;})
@@ -1111,10 +1202,12 @@ void Main::manually_parse_some_options()
     if (conf.which_sls != "yalsat" &&
         conf.which_sls != "walksat" &&
         conf.which_sls != "ccnr_yalsat" &&
-        conf.which_sls != "ccnr")
+        conf.which_sls != "ccnr" &&
+        conf.which_sls != "probsat" &&
+        conf.which_sls != "auto")
     {
         cout << "ERROR: you gave '" << conf.which_sls << " for SLS with the option '--slstype'."
-        << " This is incorrect, we only accept 'yalsat' and 'walksat'"
+        << " This is incorrect, we only accept 'ccnr', 'probsat' and 'auto'"
         << endl;
     }
 
@@ -1129,6 +1222,11 @@ void Main::manually_parse_some_options()
         exit(-1);
     }
 
+    if (conf.vsids_heap_arity != 2 && conf.vsids_heap_arity != 4 && conf.vsids_heap_arity != 8) {
+        cout << "ERROR: '--vsidsheap' must be 2, 4 or 8" << endl;
+        exit(-1);
+    }
+
     if (conf.maxXorToFind > MAX_XOR_RECOVER_SIZE) {
         cout << "ERROR: The '--maxxorsize' parameter cannot be larger than " << MAX_XOR_RECOVER_SIZE << endl;
         exit(-1);
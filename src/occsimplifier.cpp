@@ -803,6 +803,7 @@ void OccSimplifier::eliminate_xor_vars()
     const double time_used = cpuTime() - my_time;
     const bool time_out = (*limit_to_decrease <= 0);
     const double time_remain =  float_div(*limit_to_decrease, orig_xor_varelim_time_limit);
+    solver->add_inproc_ticks(orig_xor_varelim_time_limit, *limit_to_decrease);
     verb_print(1,"[occ-xor-bve] elimed: " << elimed << solver->conf.print_times(time_used, time_out));
     if (solver->sqlStats)
         solver->sqlStats->time_passed( solver , "xor-bve" , time_used , time_out , time_remain);
@@ -850,6 +851,7 @@ void OccSimplifier::eliminate_empty_resolvent_vars()
     const double time_used = cpuTime() - my_time;
     const bool time_out = (*limit_to_decrease <= 0);
     const double time_remain =  float_div(*limit_to_decrease, orig_empty_varelim_time_limit);
+    solver->add_inproc_ticks(orig_empty_varelim_time_limit, *limit_to_decrease);
     if (solver->conf.verbosity) {
         cout
         << "c [occ-empty-res] Empty resolvent elimed: " << var_elimed
@@ -1468,6 +1470,7 @@ end:
     const double time_used = cpuTime() - my_time;
     const bool time_out = (*limit_to_decrease <= 0);
     const double time_remain = float_div(*limit_to_decrease, orig_norm_varelim_time_limit);
+    solver->add_inproc_ticks(orig_norm_varelim_time_limit, *limit_to_decrease);
 
     verb_print(1, "#try to eliminate: "<< print_value_kilo_mega(wenThrough));
     verb_print(1, "#var-elim        : "<< print_value_kilo_mega(vars_elimed));
@@ -2329,7 +2332,11 @@ bool OccSimplifier::execute_simplifier_strategy(const string& strategy)
         } else if (token == "occ-cl-rem-with-orgates") {
             cl_rem_with_or_gates();
         } else if (token == "occ-bva") {
-            // nothing, ignore BVA
+            // BVA has been removed: it would need an outside<->outer variable
+            // map so that added variables stay hidden from the user.
+            if (solver->conf.do_bva) {
+                verb_print(1, "[occ-bva] BVA is no longer supported, skipping");
+            }
         } else if (token == "occ-resolv-subs") {
             subs_with_resolvent_clauses();
         } else if (token.empty()) {
@@ -2508,6 +2515,7 @@ bool OccSimplifier::ternary_res()
     const double time_used = cpuTime() - my_time;
     const bool time_out = (*limit_to_decrease <= 0);
     const double time_remain =  float_div(*limit_to_decrease, orig_ternary_res_time_limit);
+    solver->add_inproc_ticks(orig_ternary_res_time_limit, *limit_to_decrease);
     if (solver->conf.verbosity) {
         cout
         << "c [occ-ternary-res] Ternary"
@@ -4115,7 +4123,8 @@ bool OccSimplifier::generate_resolvents_weakened(
             }
 
             ClauseStats stats;
-            resolvents.add_resolvent(dummy, stats);
+            resolvents.add_resolvent(dummy, stats,
+                get_watched_ID(tmp_poss2[pos_at]), get_watched_ID(tmp_negs2[negs_at]));
         }
     }
 
@@ -4184,7 +4193,7 @@ bool OccSimplifier::generate_resolvents(
             }
             //must clear marking that has been set due to gate
             //strengthen_dummy_with_bins(false);
-            resolvents.add_resolvent(dummy, stats);
+            resolvents.add_resolvent(dummy, stats, get_watched_ID(*it), get_watched_ID(*it2));
         }
     }
 
@@ -4529,9 +4538,16 @@ void OccSimplifier::print_var_eliminate_stat(const Lit lit) const
     printOccur(~lit);
 }
 
+int32_t OccSimplifier::get_watched_ID(const Watched& w) const
+{
+    if (w.isBin()) return w.get_ID();
+    return solver->cl_alloc.ptr(w.get_offset())->stats.ID;
+}
+
 bool OccSimplifier::add_varelim_resolvent(
     vector<Lit>& finalLits
     , const ClauseStats& stats
+    , const std::pair<int32_t, int32_t>& antecs
 ) {
     assert(solver->okay());
     assert(solver->prop_at_head());
@@ -4546,6 +4562,17 @@ bool OccSimplifier::add_varelim_resolvent(
         << endl;
     }
 
+    //Hints: the units of literals since set false, then the two clauses
+    //resolved. The first one propagates the pivot, the second conflicts
+    solver->chain.clear();
+    if (solver->frat->enabled()) {
+        for(const Lit l: finalLits) {
+            if (solver->value(l) == l_False) solver->chain.push_back(solver->unit_cl_IDs[l.var()]);
+        }
+        solver->chain.push_back(antecs.first);
+        solver->chain.push_back(antecs.second);
+    }
+
     ClauseStats backup_stats(stats);
     newCl = solver->add_clause_int(
         finalLits //Literals in new clause
@@ -4553,6 +4580,11 @@ bool OccSimplifier::add_varelim_resolvent(
         , &backup_stats//Statistics for this new clause (usage, etc.)
         , false //Should clause be attached if long?
         , &finalLits //Return final set of literals here
+        , true //add to FRAT
+        , lit_Undef
+        , false //sorted
+        , false //remove old clause from proof
+        , true //FRAT hints in solver->chain
     );
 
     if (solver->okay()) {
@@ -4826,7 +4858,8 @@ bool OccSimplifier::maybe_eliminate(const uint32_t var)
 
     //Add resolvents
     while(!resolvents.empty()) {
-        if (!add_varelim_resolvent(resolvents.back_lits(), resolvents.back_stats())) goto end;
+        if (!add_varelim_resolvent(resolvents.back_lits(), resolvents.back_stats(),
+                resolvents.back_antecs())) goto end;
         resolvents.pop();
     }
 
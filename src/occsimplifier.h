@@ -466,7 +466,9 @@ private:
     vector<Clause*> toclear_marked_cls;
     set<uint32_t> parities_found;
     void        print_var_eliminate_stat(Lit lit) const;
-    bool        add_varelim_resolvent(vector<Lit>& finalLits, const ClauseStats& stats);
+    bool        add_varelim_resolvent(vector<Lit>& finalLits, const ClauseStats& stats,
+                                      const std::pair<int32_t, int32_t>& antecs);
+    int32_t     get_watched_ID(const Watched& w) const;
     void        update_varelim_complexity_heap();
     void        print_var_elim_complexity_stats(const uint32_t var) const;
 
@@ -481,17 +483,21 @@ private:
         uint32_t at = 0;
         vector<vector<Lit>> resolvents_lits;
         vector<ClauseStats> resolvents_stats;
+        vector<std::pair<int32_t, int32_t>> resolvents_antecs; //IDs, for FRAT hints
         void clear() {
             at = 0;
         }
-        void add_resolvent(const vector<Lit>& res, const ClauseStats& stats) {
+        void add_resolvent(const vector<Lit>& res, const ClauseStats& stats,
+                           const int32_t ID1, const int32_t ID2) {
             if (resolvents_lits.size() < at+1) {
                 resolvents_lits.resize(at+1);
                 resolvents_stats.resize(at+1);
+                resolvents_antecs.resize(at+1);
             }
 
             resolvents_lits[at] = res;
             resolvents_stats[at] = stats;
+            resolvents_antecs[at] = std::make_pair(ID1, ID2);
             at++;
         }
         vector<Lit>& back_lits() {
@@ -502,6 +508,10 @@ private:
             assert(at > 0);
             return resolvents_stats[at-1];
         }
+        const std::pair<int32_t, int32_t>& back_antecs() const {
+            assert(at > 0);
+            return resolvents_antecs[at-1];
+        }
         void pop() {
             at--;
         }
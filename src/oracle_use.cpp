@@ -22,6 +22,9 @@ THE SOFTWARE.
 
 #include "solver.h"
 #include "oracle/oracle.h"
+#include <algorithm>
+#include <memory>
+#include <thread>
 
 using namespace CMSat;
 
@@ -74,6 +77,34 @@ vector<vector<int>> Solver::get_irred_cls_for_oracle() const
     return clauses;
 }
 
+// Shortens clauses[from..to) one literal at a time with the oracle.
+// Returns 1 if all were done, 0 if it ran out of mems, -1 on the empty clause
+static int oracle_vivif_range(
+    sspp::oracle::Oracle& oracle,
+    vector<vector<int>>& clauses,
+    const size_t from,
+    const size_t to)
+{
+    for (int i = from; i < (int)to; i++) {
+        for (int j = 0; j < (int)clauses[i].size(); j++) {
+            if (oracle.getStats().mems > 1600LL*1000LL*1000LL) return 0;
+            auto assump = negate(clauses[i]);
+            swapdel(assump, j);
+            auto ret = oracle.Solve(assump, true, 500LL*1000LL*1000LL);
+            if (ret.isUnknown()) return 0;
+            if (ret.isFalse()) {
+                sort(assump.begin(), assump.end());
+                auto clause = negate(assump);
+                oracle.AddClauseIfNeededAndStr(clause, true);
+                clauses[i] = clause;
+                j = -1; //start from beginning
+                if (clause.empty()) return -1;
+            }
+        }
+    }
+    return 1;
+}
+
 bool Solver::oracle_vivif(bool& finished)
 {
     assert(!frat->enabled());
@@ -89,36 +120,36 @@ bool Solver::oracle_vivif(bool& finished)
     auto clauses = get_irred_cls_for_oracle();
     detach_and_free_all_irred_cls();
 
-    sspp::oracle::Oracle oracle(nVars(), clauses, {});
-    oracle.SetVerbosity(conf.verbosity);
-    bool sat = false;
-    for (int i = 0; i < (int)clauses.size(); i++) {
-        for (int j = 0; j < (int)clauses[i].size(); j++) {
-            if (oracle.getStats().mems > 1600LL*1000LL*1000LL) goto end;
-            auto assump = negate(clauses[i]);
-            swapdel(assump, j);
-            auto ret = oracle.Solve(assump, true, 500LL*1000LL*1000LL);
-            if (ret.isUnknown()) {
-                goto end;
-            }
-            if (ret.isFalse()) {
-                sort(assump.begin(), assump.end());
-                auto clause = negate(assump);
-                oracle.AddClauseIfNeededAndStr(clause, true);
-                clauses[i] = clause;
-                j = -1; //start from beginning
-                if (clause.empty()) {
-                    ok = false;
-                    return false;
-                }
-            } else if(!sat) {
-                sat = true;
-            }
-        }
+    // Every clause shortened is implied by the original clause set, so the
+    // chunks can be vivified independently, each against its own oracle
+    // built from the same snapshot
+    const size_t nthreads = std::max<size_t>(1,
+        std::min<size_t>(conf.oracle_threads, clauses.size()/100));
+    vector<std::unique_ptr<sspp::oracle::Oracle>> oracles(nthreads);
+    vector<int> res(nthreads, 1);
+    if (nthreads == 1) {
+        oracles[0].reset(new sspp::oracle::Oracle(nVars(), clauses, {}));
+        oracles[0]->SetVerbosity(conf.verbosity);
+        res[0] = oracle_vivif_range(*oracles[0], clauses, 0, clauses.size());
+    } else {
+        const vector<vector<int>> snapshot(clauses);
+        auto vivif_chunk = [&](const size_t t) {
+            oracles[t].reset(new sspp::oracle::Oracle(nVars(), snapshot, {}));
+            if (t == 0) oracles[t]->SetVerbosity(conf.verbosity);
+            res[t] = oracle_vivif_range(*oracles[t], clauses,
+                t*clauses.size()/nthreads, (t+1)*clauses.size()/nthreads);
+        };
+        vector<std::thread> thds;
+        for(size_t t = 1; t < nthreads; t++) thds.push_back(std::thread(vivif_chunk, t));
+        vivif_chunk(0);
+        for(std::thread& t: thds) t.join();
+    }
+    for(const int r: res) if (r == -1) {
+        ok = false;
+        return false;
     }
-    finished |= true;
+    finished |= std::all_of(res.begin(), res.end(), [](const int r) { return r == 1; });
 
-    end:
     vector<Lit> tmp2;
     for(const auto& cl: clauses) {
         tmp2.clear();
@@ -129,23 +160,32 @@ bool Solver::oracle_vivif(bool& finished)
     }
 
     if (conf.oracle_get_learnts) {
-        for (const auto& cl: oracle.GetLearnedClauses()) {
-            tmp2.clear();
-            for(const auto& l: cl) tmp2.push_back(orc_to_lit(l));
-            ClauseStats s;
-            s.which_red_array = 2;
-            s.ID = ++clauseID;
-            s.glue = cl.size();
-            Clause* cl2 = solver->add_clause_int(tmp2, true, &s);
-            if (cl2) longRedCls[2].push_back(cl_alloc.get_offset(cl2));
-            if (!okay()) return false;
+        for(const auto& oracle: oracles) {
+            for (const auto& cl: oracle->GetLearnedClauses()) {
+                tmp2.clear();
+                for(const auto& l: cl) tmp2.push_back(orc_to_lit(l));
+                ClauseStats s;
+                s.which_red_array = 2;
+                s.ID = ++clauseID;
+                s.glue = cl.size();
+                Clause* cl2 = solver->add_clause_int(tmp2, true, &s);
+                if (cl2) longRedCls[2].push_back(cl_alloc.get_offset(cl2));
+                if (!okay()) return false;
+            }
         }
     }
 
+    sspp::oracle::Stats st;
+    for(const auto& oracle: oracles) {
+        st.cache_useful += oracle->getStats().cache_useful;
+        st.cache_added += oracle->getStats().cache_added;
+        st.learned_units += oracle->getStats().learned_units;
+    }
     verb_print(1, "[oracle-vivif] finished: " << finished
-            << " cache-used: " << oracle.getStats().cache_useful
-            << " cache-added: " << oracle.getStats().cache_added
-            << " learnt-units: " << oracle.getStats().learned_units
+            << " threads: " << nthreads
+            << " cache-used: " << st.cache_useful
+            << " cache-added: " << st.cache_added
+            << " learnt-units: " << st.learned_units
             << " finished (vivif or backbone): " << finished
             << " T: " << std::setprecision(2) << (cpuTime()-my_time));
     return solver->okay();
@@ -275,13 +315,10 @@ bool Solver::oracle_sparsify()
     assert(cs.size() == tot_cls);
     //dump_cls_oracle("debug.xt", cs);
 
-    // The "+tot_cls" is for indicator variables
-    sspp::oracle::Oracle oracle(nVars()+tot_cls, {});
-    oracle.SetVerbosity(conf.verbosity);
-    vector<sspp::Lit> tmp;
+    vector<vector<sspp::Lit>> ind_cls(tot_cls);
     for(uint32_t i = 0; i < cs.size(); i++) {
         const auto& c = cs[i];
-        tmp.clear();
+        auto& tmp = ind_cls[i];
         if (!c.binary) {
             Clause& cl = *cl_alloc.ptr(c.off);
             for(auto const& l: cl) assert(l.var() < nVars());
@@ -295,28 +332,26 @@ bool Solver::oracle_sparsify()
         }
         // Indicator variable
         tmp.push_back(orclit(Lit(nVars()+i, false)));
-        oracle.AddClause(tmp, false);
-    }
-    const double build_time = cpuTime() - my_time;
-
-    // Set all assumptions to FALSE, i.e. all clauses are active
-    for (uint32_t i = 0; i < tot_cls; i++) {
-        oracle.SetAssumpLit(orclit(Lit(nVars()+i, true)), false);
     }
 
-    // Now try to remove clauses one-by-one
-    uint32_t last_printed = 0;
-    for (uint32_t i = 0; i < tot_cls; i++) {
-        if ((10*i)/(tot_cls) != last_printed) {
-            verb_print(1, "[oracle-sparsify] done with " << ((10*i)/(tot_cls))*10 << " %"
-                << " oracle mems: " << print_value_kilo_mega(oracle.getStats().mems)
-                << " T: " << (cpuTime()-my_time));
-            last_printed = (10*i)/(tot_cls);
+    // The "+tot_cls" is for indicator variables
+    auto build_oracle = [&](const uint32_t verb) {
+        auto oracle = new sspp::oracle::Oracle(nVars()+tot_cls, {});
+        oracle->SetVerbosity(verb);
+        for(const auto& cl: ind_cls) oracle->AddClause(cl, false);
+
+        // Set all assumptions to FALSE, i.e. all clauses are active
+        for (uint32_t i = 0; i < tot_cls; i++) {
+            oracle->SetAssumpLit(orclit(Lit(nVars()+i, true)), false);
         }
+        return oracle;
+    };
 
-        // Try removing this clause, making its indicator TRUE (i.e. removed)
+    // Try removing clause i, making its indicator TRUE (i.e. removed).
+    // Returns 1 if removed, 0 if needed, -1 if out of time
+    auto try_remove = [&](sspp::oracle::Oracle& oracle, const uint32_t i) {
         oracle.SetAssumpLit(orclit(Lit(nVars()+i, false)), false);
-        tmp.clear();
+        vector<sspp::Lit> tmp;
         const auto& c = cs[i];
         if (!c.binary) {
             Clause& cl = *cl_alloc.ptr(c.off);
@@ -327,36 +362,101 @@ bool Solver::oracle_sparsify()
         }
 
         auto ret = oracle.Solve(tmp, false, 600LL*1000LL*1000LL);
-        if (ret.isUnknown()) { /*out of time*/ goto fin; }
-
+        if (ret.isUnknown()) return -1;
         if (ret.isTrue()) {
             // We need this clause, can't remove
             oracle.SetAssumpLit(orclit(Lit(nVars()+i, true)), true);
-        } else {
-            assert(ret.isFalse());
-            // We can freeze(!) this clause to be disabled.
-            oracle.SetAssumpLit(orclit(Lit(nVars()+i, false)), true);
-            removed++;
-            if (!c.binary) {
-                Clause& cl = *cl_alloc.ptr(c.off);
-                assert(!cl.stats.marked_clause);
-                cl.stats.marked_clause = 1;
-            } else {
-                removed_bin++;
-                Lit lit1 = c.bin.l1;
-                Lit lit2 = c.bin.l2;
-                findWatchedOfBin(watches, lit1, lit2, false, c.bin.ID).mark_bin_cl();
-                findWatchedOfBin(watches, lit2, lit1, false, c.bin.ID).mark_bin_cl();
+            return 0;
+        }
+        assert(ret.isFalse());
+        // We can freeze(!) this clause to be disabled.
+        oracle.SetAssumpLit(orclit(Lit(nVars()+i, false)), true);
+        return 1;
+    };
+
+    // Now try to remove clauses one-by-one. Each chunk is checked by its own
+    // oracle, in which all other chunks' clauses are still present
+    const uint32_t nthreads = std::max<uint32_t>(1,
+        std::min<uint32_t>(conf.oracle_threads, tot_cls/100));
+    vector<std::unique_ptr<sspp::oracle::Oracle>> oracles(nthreads);
+    vector<uint8_t> removable(tot_cls, 0);
+    double build_time = 0;
+    auto sparsify_range = [&](const uint32_t t) {
+        oracles[t].reset(build_oracle(t == 0 ? conf.verbosity : 0));
+        if (t == 0) build_time = cpuTime() - my_time;
+        sspp::oracle::Oracle& oracle = *oracles[t];
+        const uint32_t from = (uint64_t)t*tot_cls/nthreads;
+        const uint32_t to = (uint64_t)(t+1)*tot_cls/nthreads;
+        uint32_t last_printed = 0;
+        for (uint32_t i = from; i < to; i++) {
+            if (t == 0 && (10*(i-from))/(to-from) != last_printed) {
+                verb_print(1, "[oracle-sparsify] done with " << ((10*(i-from))/(to-from))*10 << " %"
+                    << " oracle mems: " << print_value_kilo_mega(oracle.getStats().mems)
+                    << " T: " << (cpuTime()-my_time));
+                last_printed = (10*(i-from))/(to-from);
+            }
+
+            const int ret = try_remove(oracle, i);
+            if (ret == -1) { /*out of time*/ return; }
+            removable[i] = ret;
+            if (oracle.getStats().mems > 900LL*1000LL*1000LL) {
+                verb_print(1, "[oracle-sparsify] too many mems in oracle, aborting");
+                return;
             }
         }
+    };
+    if (nthreads == 1) {
+        sparsify_range(0);
+    } else {
+        vector<std::thread> thds;
+        for(uint32_t t = 1; t < nthreads; t++) thds.push_back(std::thread(sparsify_range, t));
+        sparsify_range(0);
+        for(std::thread& t: thds) t.join();
+    }
 
-        if (oracle.getStats().mems > 900LL*1000LL*1000LL) {
-            verb_print(1, "[oracle-sparsify] too many mems in oracle, aborting");
-            goto fin;
+    // The first chunk's removals hold as they are: its oracle had all other
+    // clauses. The other chunks' removals are re-checked in that oracle, in
+    // order, so that no clause is removed based on another removed one.
+    // What any chunk found needed is needed also with fewer clauses.
+    uint32_t recheck_failed = 0;
+    if (nthreads > 1) {
+        sspp::oracle::Oracle& oracle = *oracles[0];
+        const int64_t mems_start = oracle.getStats().mems;
+        for (uint32_t i = (uint64_t)tot_cls/nthreads; i < tot_cls; i++) {
+            if (!removable[i]) continue;
+            if (oracle.getStats().mems - mems_start > 900LL*1000LL*1000LL) {
+                std::fill(removable.begin()+i, removable.end(), 0);
+                break;
+            }
+            const int ret = try_remove(oracle, i);
+            if (ret != 1) {
+                removable[i] = 0;
+                recheck_failed++;
+            }
+            if (ret == -1) {
+                std::fill(removable.begin()+i, removable.end(), 0);
+                break;
+            }
+        }
+    }
+
+    for (uint32_t i = 0; i < tot_cls; i++) {
+        if (!removable[i]) continue;
+        const auto& c = cs[i];
+        removed++;
+        if (!c.binary) {
+            Clause& cl = *cl_alloc.ptr(c.off);
+            assert(!cl.stats.marked_clause);
+            cl.stats.marked_clause = 1;
+        } else {
+            removed_bin++;
+            Lit lit1 = c.bin.l1;
+            Lit lit2 = c.bin.l2;
+            findWatchedOfBin(watches, lit1, lit2, false, c.bin.ID).mark_bin_cl();
+            findWatchedOfBin(watches, lit2, lit1, false, c.bin.ID).mark_bin_cl();
         }
     }
 
-    fin:
     uint32_t bin_red_added = 0;
     uint32_t bin_irred_removed = 0;
     for(auto& ws: watches) {
@@ -413,12 +513,20 @@ bool Solver::oracle_sparsify()
     //cout << "New cls size: " << clauses.size() << endl;
     //Subsume();
 
+    sspp::oracle::Stats st;
+    for(const auto& oracle: oracles) {
+        st.cache_useful += oracle->getStats().cache_useful;
+        st.cache_added += oracle->getStats().cache_added;
+        st.learned_units += oracle->getStats().learned_units;
+    }
     verb_print(1, "[oracle-sparsify] removed: " << removed
         << " of which bin: " << removed_bin
         << " tot considered: " << tot_cls
-        << " cache-used: " << oracle.getStats().cache_useful
-        << " cache-added: " << oracle.getStats().cache_added
-        << " learnt-units: " << oracle.getStats().learned_units
+        << " threads: " << nthreads
+        << " recheck-failed: " << recheck_failed
+        << " cache-used: " << st.cache_useful
+        << " cache-added: " << st.cache_added
+        << " learnt-units: " << st.learned_units
         << " T: " << (cpuTime()-my_time) << " buildT: " << build_time);
 
     return solver->okay();
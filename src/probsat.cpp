@@ -0,0 +1,197 @@
+/******************************************
+Copyright (C) 2009-2020 Authors of CryptoMiniSat, see AUTHORS file
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#include "probsat.h"
+
+#include <cmath>
+#include <cassert>
+#include <iostream>
+#include <algorithm>
+
+using namespace CCNR;
+using std::cout;
+using std::endl;
+
+bool probsat_solver::make_space(const formula* f)
+{
+    _f = f;
+    _num_vars = f->num_vars;
+    _num_clauses = f->num_clauses;
+    if (0 == _num_vars || 0 == _num_clauses) return false;
+
+    _solution.resize(_num_vars+1);
+    _best_solution.resize(_num_vars+1);
+    _break.resize(_num_vars+1);
+    _num_true.resize(_num_clauses);
+    _true_xor.resize(_num_clauses);
+    _index_in_unsat_clauses.resize(_num_clauses);
+    set_prob_table();
+
+    return true;
+}
+
+//Parameters of Balint & Schoening for uniform k-SAT: polynomial for 3-SAT,
+//exponential above. Mixed-length formulas use their average length.
+void probsat_solver::set_prob_table()
+{
+    const double avg_len = (double)_f->cl_lits.size()/(double)_num_clauses;
+    if (avg_len < 3.5) {
+        const double cb = 2.06;
+        const double eps = 0.9;
+        for (uint32_t b = 0; b < prob_table_sz; b++) {
+            _prob_table[b] = std::pow(eps + b, -cb);
+        }
+    } else {
+        double cb;
+        if (avg_len < 4.5) cb = 3.0;
+        else if (avg_len < 5.5) cb = 3.7;
+        else if (avg_len < 6.5) cb = 5.1;
+        else cb = 5.4;
+        for (uint32_t b = 0; b < prob_table_sz; b++) {
+            _prob_table[b] = std::pow(cb, -(double)b);
+        }
+    }
+}
+
+void probsat_solver::initialize(const vector<bool> *init_solution)
+{
+    for (int v = 1; v <= _num_vars; v++) {
+        if (init_solution) _solution[v] = (*init_solution)[v];
+        else _solution[v] = _random_gen.next(2);
+        _break[v] = 0;
+    }
+
+    _unsat_clauses.clear();
+    for (int c = 0; c < _num_clauses; c++) {
+        uint32_t num_true = 0;
+        uint32_t true_xor = 0;
+        for (lit l: _f->lits_of(c)) {
+            if (_solution[l.var_num] == l.sense) {
+                num_true++;
+                true_xor ^= l.var_num;
+            }
+        }
+        _num_true[c] = num_true;
+        _true_xor[c] = true_xor;
+        if (num_true == 0) unsat_clause(c);
+        else if (num_true == 1) _break[true_xor]++;
+    }
+    _mems += _f->cl_lits.size()/4;
+}
+
+int probsat_solver::pick_var(int c)
+{
+    const span<lit> lits = _f->lits_of(c);
+    _probs.resize(lits.size());
+    double sum = 0;
+    for (uint32_t i = 0; i < lits.size(); i++) {
+        const uint32_t b = std::min(_break[lits[i].var_num], prob_table_sz-1);
+        sum += _prob_table[b];
+        _probs[i] = sum;
+    }
+
+    const double r = _random_gen.nextHalfOpen()*sum;
+    uint32_t i = 0;
+    while (i+1 < lits.size() && _probs[i] <= r) i++;
+    return lits[i].var_num;
+}
+
+void probsat_solver::flip(int flipv)
+{
+    _solution[flipv] = 1 - _solution[flipv];
+    _flips++;
+    const span<occ> occs = _f->occs_of(flipv);
+    _mems += occs.size();
+
+    for (occ o: occs) {
+        const int c = o.clause_num;
+        if (_solution[flipv] == o.sense) {
+            _num_true[c]++;
+            if (_num_true[c] == 1) {
+                sat_clause(c);
+                _break[flipv]++;
+            } else if (_num_true[c] == 2) {
+                _break[_true_xor[c]]--;
+            }
+            _true_xor[c] ^= flipv;
+        } else {
+            _num_true[c]--;
+            _true_xor[c] ^= flipv;
+            if (_num_true[c] == 0) {
+                unsat_clause(c);
+                _break[flipv]--;
+            } else if (_num_true[c] == 1) {
+                _break[_true_xor[c]]++;
+            }
+        }
+    }
+}
+
+void probsat_solver::sat_clause(int c)
+{
+    const int last_item = _unsat_clauses.back();
+    _unsat_clauses.pop_back();
+    const int index = _index_in_unsat_clauses[c];
+    if (index < (int)_unsat_clauses.size()) {
+        _unsat_clauses[index] = last_item;
+        _index_in_unsat_clauses[last_item] = index;
+    }
+}
+
+void probsat_solver::unsat_clause(int c)
+{
+    _index_in_unsat_clauses[c] = _unsat_clauses.size();
+    _unsat_clauses.push_back(c);
+}
+
+bool probsat_solver::local_search(
+    const vector<bool> *init_solution
+    , long long int _mems_limit
+) {
+    _mems = 0;
+    _flips = 0;
+    _random_gen.seed(_random_seed);
+    _conflict_ct.clear();
+    _conflict_ct.resize(_num_vars+1, 0);
+
+    initialize(init_solution);
+    _best_found_cost = _unsat_clauses.size();
+    std::copy(_solution.begin(), _solution.end(), _best_solution.begin());
+
+    while (!_unsat_clauses.empty() && _mems <= _mems_limit) {
+        const int c = _unsat_clauses[_random_gen.next(_unsat_clauses.size())];
+        for (lit l: _f->lits_of(c)) _conflict_ct[l.var_num]++;
+        _mems += _f->lits_of(c).size()/2;
+        flip(pick_var(c));
+
+        if ((int)_unsat_clauses.size() < _best_found_cost) {
+            _best_found_cost = _unsat_clauses.size();
+            std::copy(_solution.begin(), _solution.end(), _best_solution.begin());
+        }
+        if (_verbosity && (_flips & 0x3ffff) == 0x3ffff) {
+            cout << "c [probsat] flips: " << _flips
+            << " best found: " << _best_found_cost << endl;
+        }
+    }
+
+    return _best_found_cost == 0;
+}
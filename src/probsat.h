@@ -0,0 +1,87 @@
+/******************************************
+Copyright (C) 2009-2020 Authors of CryptoMiniSat, see AUTHORS file
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+***********************************************/
+
+#ifndef PROBSAT_H
+#define PROBSAT_H
+
+#include <cstdint>
+#include <vector>
+#include "ccnr.h"
+#include "ccnr_mersenne.h"
+
+namespace CCNR {
+
+//probSAT (Balint & Schoening, SAT'12) on the same CSR formula CCNR uses.
+//Break-only scoring: break counts are kept up to date on every flip, the
+//var to flip is drawn from the falsified clause with probabilities looked
+//up in a table indexed by break count.
+class probsat_solver
+{
+   public:
+    bool make_space(const formula* f);
+    bool local_search(
+        const vector<bool> *init_solution
+        , long long int _mems_limit
+    );
+    int get_best_cost() const { return _best_found_cost; }
+    long long get_flips() const { return _flips; }
+    void set_seed(int seed) { _random_seed = seed; }
+    void set_verbosity(uint32_t verb) { _verbosity = verb; }
+
+    //indexed by var, as in ls_solver
+    vector<uint8_t> _best_solution;
+    vector<int> _conflict_ct; //how often the var was in the picked clause
+
+   private:
+    const formula* _f = nullptr;
+    int _num_vars = 0;
+    int _num_clauses = 0;
+
+    vector<uint8_t> _solution;
+    vector<uint32_t> _num_true; //no. of true literals of the clause
+    vector<uint32_t> _true_xor; //xor of the vars of its true literals
+    vector<uint32_t> _break;    //no. of clauses the var is the only true one in
+    vector<int> _unsat_clauses;
+    vector<int> _index_in_unsat_clauses;
+
+    static constexpr uint32_t prob_table_sz = 64;
+    double _prob_table[prob_table_sz];
+    vector<double> _probs;
+
+    Mersenne _random_gen;
+    int _random_seed = 1;
+    int _best_found_cost = 0;
+    long long _mems = 0;
+    long long _flips = 0;
+    uint32_t _verbosity = 0;
+
+    void set_prob_table();
+    void initialize(const vector<bool> *init_solution);
+    int pick_var(int c);
+    void flip(int flipv);
+    void sat_clause(int c);
+    void unsat_clause(int c);
+};
+
+} // namespace CCNR
+
+#endif
@@ -60,6 +60,7 @@ PropEngine::PropEngine(
         , qhead(0)
         , solver(_solver)
 {
+    order_heap_vsids.set_arity(conf.vsids_heap_arity);
 }
 
 PropEngine::~PropEngine()
@@ -604,7 +605,7 @@ bool PropEngine::prop_long_cl_any_order(
         *j++ = *i;
         return true;
     }
-    if (inprocess) propStats.bogoProps += 4;
+    propStats.bogoProps += 4;
     const ClOffset offset = i->get_offset();
     Clause& c = *cl_alloc.ptr(offset);
 
@@ -725,9 +726,7 @@ PropBy PropEngine::propagate_any_order()
         Watched* i = ws.begin();
         Watched* j = i;
         Watched* end = ws.end();
-        if (inprocess) {
-            propStats.bogoProps += ws.size()/4 + 1;
-        }
+        propStats.bogoProps += ws.size()/4 + 1;
         propStats.propagations++;
         simpDB_props--;
         for (; i != end; i++) {
@@ -1143,3 +1142,55 @@ vector<Lit>* PropEngine::get_xor_reason(const PropBy& reason, int32_t& ID) {
 
     }
 }
+
+// Adds unit 'p' derived at level 0, or the empty clause if 'p' is lit_Undef
+// and 'from' is a conflict, hinted by 'from' and the units that made the rest
+// of it false. No hints if any of these has no ID.
+void PropEngine::frat_add_level0(const int32_t ID, const Lit p, const PropBy from)
+{
+    int32_t r_ID = 0;
+    const Lit* lits = nullptr;
+    uint32_t size = 0;
+    Lit bin[2];
+    switch (from.getType()) {
+        case binary_t:
+            r_ID = from.getID();
+            bin[0] = (p == lit_Undef) ? failBinLit : p;
+            bin[1] = from.lit2();
+            lits = bin;
+            size = 2;
+            break;
+        case clause_t: {
+            const Clause* cl = cl_alloc.ptr(from.get_offset());
+            r_ID = cl->stats.ID;
+            lits = cl->begin();
+            size = cl->size();
+            break;
+        }
+        case xor_t: {
+            //Writes the reason into the proof, so must come first
+            const vector<Lit>* cl = get_xor_reason(from, r_ID);
+            lits = cl->data();
+            size = cl->size();
+            break;
+        }
+        default:
+            break;
+    }
+
+    bool hint = r_ID != 0;
+    for(uint32_t i = 0; i < size && hint; i++) {
+        if (lits[i] != p && unit_cl_IDs[lits[i].var()] == 0) hint = false;
+    }
+
+    *frat << add << ID;
+    if (p != lit_Undef) *frat << p;
+    if (hint) {
+        *frat << fratchain;
+        for(uint32_t i = 0; i < size; i++) {
+            if (lits[i] != p) *frat << unit_cl_IDs[lits[i].var()];
+        }
+        *frat << r_ID;
+    }
+    *frat << fin;
+}
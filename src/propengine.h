@@ -216,6 +216,18 @@ public:
     void reverse_prop(const Lit l);
     void reverse_one_bnn(uint32_t idx, BNNPropType t);
     PropStats propStats;
+
+    //Inprocessing effort in ticks, the unit of propStats.bogoProps, i.e.
+    //roughly a cache line visited. Simplifiers that propagate are accounted
+    //for by the bogoProps they cause, the others report here how much of
+    //their budget they used up.
+    uint64_t inproc_ticks = 0;
+    void add_inproc_ticks(const int64_t budget, const int64_t remain)
+    {
+        if (budget > remain) inproc_ticks += budget - remain;
+    }
+    uint64_t ticks() const { return propStats.bogoProps + inproc_ticks; }
+
     template<bool inprocess>
     void enqueue(const Lit p, const uint32_t level,
                  const PropBy from = PropBy(), const bool do_unit_frat = true);
@@ -223,6 +235,8 @@ public:
     void enqueue_light(const Lit p);
     void new_decision_level();
     vector<Lit>* get_xor_reason(const PropBy& reason, int32_t& ID);
+    void frat_add_level0(const int32_t ID, const Lit p, const PropBy from);
+    void enqueue_frat_unit(const Lit p, const int32_t ID, const uint32_t level);
 
     /////////////////////
     // Branching
@@ -571,24 +585,7 @@ void PropEngine::enqueue(const Lit p, const uint32_t level, const PropBy from, b
     {   if (do_unit_frat) {
             const auto ID = ++clauseID;
             const auto XID = ++clauseXID;
-            /* chain.clear(); */
-            if (from.getType() == PropByType::binary_t) {
-                chain.push_back(from.getID());
-                chain.push_back(unit_cl_IDs[from.lit2().var()]);
-            } else if (from.getType() == PropByType::clause_t) {
-                Clause* cl = cl_alloc.ptr(from.get_offset());
-                chain.push_back(cl->stats.ID);
-                for(auto const& l: *cl) if (l != p) chain.push_back(unit_cl_IDs[l.var()]);
-            } else {
-                // These are too difficult and not worth it
-            }
-
-            if (from.getType() == PropByType::xor_t) {
-                int32_t tmp_ID;
-                get_xor_reason(from, tmp_ID);
-            }
-
-            *frat << add << ID << p << fin;
+            frat_add_level0(ID, p, from);
 	    if (frat && !frat->incremental())
               *frat << implyxfromcls << XID << p << fratchain << ID << fin;
 
@@ -706,6 +703,22 @@ PropBy PropEngine::propagate_light()
     return confl;
 }
 
+// Enqueues unit 'p', its clause already being in the proof as ID
+inline void PropEngine::enqueue_frat_unit(const Lit p, const int32_t ID, const uint32_t level)
+{
+    if (frat->enabled()) {
+        const uint32_t v = p.var();
+        assert(unit_cl_IDs[v] == 0);
+        assert(unit_cl_XIDs[v] == 0);
+        assert(ID != 0);
+        unit_cl_IDs[v] = ID;
+        unit_cl_XIDs[v] = ++clauseXID;
+        if (!frat->incremental())
+            *frat << implyxfromcls << unit_cl_XIDs[v] << p << fratchain << ID << fin;
+    }
+    enqueue<false>(p, level, PropBy(), false);
+}
+
 inline void PropEngine::enqueue_light(const Lit p)
 {
     const uint32_t v = p.var();
@@ -87,6 +87,7 @@ Searcher::Searcher(const SolverConf *_conf, Solver* _solver, std::atomic<bool>*
     polarity_mode = conf.polarity_mode;
 
     next_cls_distill = 5000.0*conf.global_next_multiplier;
+    next_vivify_learnt = conf.vivify_learnt_every*conf.global_next_multiplier;
     next_bins_distill = 12000.0*conf.global_next_multiplier;
     next_full_probe = 20000.0*conf.global_next_multiplier;
     next_sub_str_with_bin = 25000.0*conf.global_next_multiplier;
@@ -547,6 +548,138 @@ void Searcher::minimize_learnt_clause()
     stats.recMinLitRem += origSize - learnt_clause.size();
 }
 
+// Shrinking (Fleury & Biere, 2020). The literals of the learnt clause that
+// belong to the same decision level are replaced with the first UIP of that
+// level, if it can be reached by resolving only on literals of that level,
+// without pulling in literals of lower levels that are not already in the
+// clause. Glue stays the same, the clause gets shorter.
+void Searcher::shrink_learnt_clause()
+{
+    if (learnt_clause.size() <= 2) return;
+
+    assert(toClear.empty());
+    toClear = learnt_clause;
+    for (const Lit l: learnt_clause) seen[l.var()] = 1;
+    std::sort(learnt_clause.begin()+1, learnt_clause.end(),
+        [&](const Lit a, const Lit b) {
+            return varData[a.var()].level > varData[b.var()].level;
+        });
+
+    const size_t origSize = learnt_clause.size();
+    uint32_t j = 1;
+    for (uint32_t i = 1; i < origSize;) {
+        const uint32_t level = varData[learnt_clause[i].var()].level;
+        uint32_t end = i+1;
+        while (end < origSize && varData[learnt_clause[end].var()].level == level) {
+            end++;
+        }
+
+        Lit uip = lit_Undef;
+        if (end - i > 1) {
+            stats.shrinkBlocks++;
+            uip = shrink_block(i, end, level);
+        }
+        if (uip != lit_Undef) {
+            stats.shrinkBlocksOK++;
+            learnt_clause[j++] = uip;
+            if (!seen[uip.var()]) {
+                //Not bumped during 1UIP analysis
+                if (branch_strategy == branch::vsids) vsids_bump_var_act<false>(uip.var());
+                if (branch_strategy == branch::vmtf) implied_by_learnts.push_back(uip.var());
+            }
+        } else {
+            for (uint32_t k = i; k < end; k++) learnt_clause[j++] = learnt_clause[k];
+        }
+        i = end;
+    }
+
+    for (const Lit l: toClear) seen[l.var()] = 0;
+    toClear.clear();
+    learnt_clause.resize(j);
+    stats.shrinkLitRem += origSize - j;
+}
+
+// Walks the trail backwards from the latest literal of the block, resolving
+// away literals of the block's level until only one is left. Returns the
+// (false) UIP literal or lit_Undef if the block cannot be shrunk.
+Lit Searcher::shrink_block(const uint32_t begin, const uint32_t end, const uint32_t level)
+{
+    assert(shrink_marked.empty());
+    const size_t old_chain_size = chain.size();
+    uint32_t open = end - begin;
+    uint32_t pos = 0;
+    for (uint32_t i = begin; i < end; i++) {
+        const uint32_t v = learnt_clause[i].var();
+        seen2[v] = 1;
+        shrink_marked.push_back(v);
+        pos = std::max(pos, varData[v].sublevel);
+    }
+
+    Lit uip = lit_Undef;
+    for (;; pos--) {
+        assert(pos < trail.size() && pos >= trail_lim[level-1]);
+        const Lit t = trail[pos].lit;
+        if (t == lit_Undef || !seen2[t.var()]) continue;
+        assert(varData[t.var()].level == level);
+        if (open == 1) {
+            uip = ~t;
+            break;
+        }
+        open--;
+
+        const PropBy reason = varData[t.var()].reason;
+        int32_t ID;
+        Lit* lits = nullptr;
+        uint32_t size;
+        switch (reason.getType()) {
+            case binary_t:
+                ID = reason.getID();
+                size = 1;
+                break;
+            case clause_t: {
+                Clause* cl = cl_alloc.ptr(reason.get_offset());
+                ID = cl->stats.ID;
+                lits = cl->begin()+1;
+                size = cl->size()-1;
+                break;
+            }
+            default:
+                //decision, xor or bnn reason
+                goto fail;
+        }
+        stats.recMinimCost += size;
+
+        for (uint32_t i = 0; i < size; i++) {
+            const Lit q = (lits == nullptr) ? reason.lit2() : lits[i];
+            const uint32_t qlev = varData[q.var()].level;
+            if (qlev == 0) {
+                if (frat->enabled()) chain.push_back(unit_cl_IDs[q.var()]);
+                continue;
+            }
+            if (qlev == level) {
+                if (!seen2[q.var()]) {
+                    seen2[q.var()] = 1;
+                    shrink_marked.push_back(q.var());
+                    open++;
+                }
+            } else if (!seen[q.var()]) {
+                goto fail;
+            }
+        }
+        chain.push_back(ID);
+    }
+
+    for (const auto v: shrink_marked) seen2[v] = 0;
+    shrink_marked.clear();
+    return uip;
+
+    fail:
+    for (const auto v: shrink_marked) seen2[v] = 0;
+    shrink_marked.clear();
+    chain.resize(old_chain_size);
+    return lit_Undef;
+}
+
 inline void Searcher::minimize_using_bins()
 {
     if (conf.doMinimRedMore
@@ -563,6 +696,7 @@ inline void Searcher::minimize_using_bins()
                 if (permDiff[imp.var()] == MYFLAG && value(imp) == l_True) {
                     nb++;
                     permDiff[imp.var()] = MYFLAG - 1;
+                    chain.push_back(w.get_ID());
                 }
             } else {
                 break;
@@ -674,6 +808,123 @@ void Searcher::create_learnt_clause(PropBy confl)
     learnt_clause[0] = ~p;
 }
 
+// Sets chain to the hints deriving 'cl', whose negation was enqueued as
+// decisions, from clause ID, whose literals 'lits' are all false: the units
+// and reasons they depend on, in trail order, and ID last. Literals of 'cl'
+// are not explained further. Leaves chain empty if some antecedent has no ID.
+void Searcher::chain_from_trail(
+    const vector<Lit>& cl,
+    const Lit* lits,
+    const uint32_t size,
+    const int32_t ID
+) {
+    assert(toClear.empty());
+    assert(decisionLevel() > 0);
+    chain.clear();
+    bool complete = ID != 0;
+    chain.push_back(ID);
+    for(const Lit l: cl) {
+        seen[l.var()] = 1;
+        toClear.push_back(l);
+    }
+
+    //Built backwards, reversed at the end
+    for(uint32_t i = 0; i < size; i++) {
+        const Lit q = lits[i];
+        if (seen[q.var()]) continue;
+        seen[q.var()] = 1 + (varData[q.var()].level > 0);
+        toClear.push_back(q);
+        if (varData[q.var()].level == 0) {
+            complete &= unit_cl_IDs[q.var()] != 0;
+            chain.push_back(unit_cl_IDs[q.var()]);
+        }
+    }
+    for(int64_t k = (int64_t)trail.size()-1; complete && k >= (int64_t)trail_lim[0]; k--) {
+        const Lit t = trail[k].lit;
+        if (t == lit_Undef || seen[t.var()] != 2) continue;
+
+        const PropBy reason = varData[t.var()].reason;
+        int32_t r_ID = 0;
+        const Lit* r_lits = nullptr;
+        uint32_t r_size = 0;
+        Lit r_bin;
+        switch(reason.getType()) {
+            case binary_t:
+                r_ID = reason.getID();
+                r_bin = reason.lit2();
+                r_lits = &r_bin;
+                r_size = 1;
+                break;
+            case clause_t: {
+                const Clause* c = cl_alloc.ptr(reason.get_offset());
+                r_ID = c->stats.ID;
+                r_lits = c->begin();
+                r_size = c->size();
+                break;
+            }
+            case xor_t: {
+                const vector<Lit>* c = get_xor_reason(reason, r_ID);
+                r_lits = c->data();
+                r_size = c->size();
+                break;
+            }
+            default:
+                //decision not in 'cl', or BNN
+                break;
+        }
+        if (r_ID == 0) {
+            complete = false;
+            break;
+        }
+        chain.push_back(r_ID);
+        for(uint32_t i = 0; i < r_size; i++) {
+            const Lit q = r_lits[i];
+            if (seen[q.var()]) continue;
+            seen[q.var()] = 1 + (varData[q.var()].level > 0);
+            toClear.push_back(q);
+            if (varData[q.var()].level == 0) {
+                complete &= unit_cl_IDs[q.var()] != 0;
+                chain.push_back(unit_cl_IDs[q.var()]);
+            }
+        }
+    }
+
+    for(const Lit l: toClear) seen[l.var()] = 0;
+    toClear.clear();
+    if (complete) std::reverse(chain.begin(), chain.end());
+    else chain.clear();
+}
+
+// Same, 'confl' being a conflict or the reason of a literal of 'cl'.
+// 'bin_lit' is the literal of a binary 'confl' that PropBy does not store.
+void Searcher::chain_from_trail(
+    const vector<Lit>& cl,
+    const PropBy confl,
+    const Lit bin_lit
+) {
+    int32_t ID = 0;
+    switch(confl.getType()) {
+        case binary_t: {
+            const Lit bin[2] = {bin_lit, confl.lit2()};
+            chain_from_trail(cl, bin, 2, confl.getID());
+            break;
+        }
+        case clause_t: {
+            const Clause* c = cl_alloc.ptr(confl.get_offset());
+            chain_from_trail(cl, c->begin(), c->size(), c->stats.ID);
+            break;
+        }
+        case xor_t: {
+            const vector<Lit>* c = get_xor_reason(confl, ID);
+            chain_from_trail(cl, c->data(), c->size(), ID);
+            break;
+        }
+        default:
+            chain.clear();
+            break;
+    }
+}
+
 void Searcher::simple_create_learnt_clause(
     PropBy confl,
     vector<Lit>& out_learnt,
@@ -837,6 +1088,7 @@ void Searcher::analyze_conflict(
 
 #endif
     minimize_learnt_clause<inprocess>();
+    if (!inprocess && conf.doShrinkMinim) shrink_learnt_clause();
     stats.litsRedFinal += learnt_clause.size();
 
     //further minimisation 1 -- short, small glue clauses
@@ -850,6 +1102,7 @@ void Searcher::analyze_conflict(
     if (glue == numeric_limits<uint32_t>::max()) {
         glue = calc_glue(learnt_clause);
     }
+    stats.glueFinal += glue;
     print_fully_minimized_learnt_clause();
 
     if (glue <= (conf.glue_put_lev0_if_below_or_eq+2)) {
@@ -930,7 +1183,7 @@ bool Searcher::litRedundant(const Lit p, uint32_t abstract_levels)
         //Must have a reason
         assert(!reason.isnullptr());
 
-        int32_t ID;
+        int32_t ID = 0;
         size_t size;
         Lit* lits = nullptr;
         switch (type) {
@@ -988,16 +1241,17 @@ bool Searcher::litRedundant(const Lit p, uint32_t abstract_levels)
             }
             stats.recMinimCost++;
 
-            if (!seen[p2.var()] && varData[p2.var()].level > 0) {
+            if (varData[p2.var()].level == 0) {
+                if (frat->enabled()) chain.push_back(unit_cl_IDs[p2.var()]);
+                continue;
+            }
+            if (!seen[p2.var()]) {
                 if (!varData[p2.var()].reason.isnullptr()
                     && (abstractLevel(p2.var()) & abstract_levels) != 0
                 ) {
                     seen[p2.var()] = 1;
                     analyze_stack.push(p2);
                     toClear.push_back(p2);
-
-                    chain.push_back(ID);
-                    VERBOSE_PRINT("TMP Chain adding ID: " << ID << " due to minimization, litRed on var: " << p2);
                 } else {
                     //Return to where we started before function executed
                     for (size_t j = top; j < toClear.size(); j++) {
@@ -1011,6 +1265,10 @@ bool Searcher::litRedundant(const Lit p, uint32_t abstract_levels)
                 }
             }
         }
+        //Every reason walked is an antecedent, even if all its literals
+        //were already seen
+        chain.push_back(ID);
+        VERBOSE_PRINT("TMP Chain adding ID: " << ID << " due to minimization, litRed on var: " << p_analyze);
     }
     VERBOSE_PRINT("Chain TMPs were OK, not clearing");
 
@@ -1249,8 +1507,10 @@ lbool Searcher::search()
     stats.numRestarts++;
     hist.clear();
     hist.reset_glueHist_size(conf.shortTermHistorySize);
+    target_trail = 0;
 
-    assert(solver->prop_at_head());
+    //A partial restart leaves the kept levels to be propagated
+    assert(decisionLevel() > 0 || solver->prop_at_head());
 
     //Loop until restart or finish (SAT/UNSAT)
     PropBy confl;
@@ -1300,6 +1560,16 @@ lbool Searcher::search()
     }
     max_confl_this_restart -= (int64_t)params.confl_this_rst;
 
+    if (can_reuse_trail()) {
+        const uint32_t reuse_level = trail_reuse_level();
+        if (reuse_level > 0) {
+            stats.partialRestarts++;
+            stats.reusedLevels += reuse_level;
+            cancelUntil(reuse_level);
+            goto end;
+        }
+    }
+
     cancelUntil(0);
     confl = propagate<false>();
     if (!confl.isnullptr() || !solver->datasync->syncData()) {
@@ -1437,18 +1707,7 @@ void Searcher::attach_and_enqueue_learnt_clause(
             stats.learntUnits++;
             if (enq) {
                 assert(level == 0);
-                uint32_t v = learnt_clause[0].var();
-                if (frat->enabled()) {
-                    assert(unit_cl_IDs[v] == 0);
-                    assert(unit_cl_XIDs[v] == 0);
-                    assert(ID != 0);
-                    unit_cl_IDs[v] = ID;
-                    const auto XID = ++clauseXID;
-		    if (!frat->incremental())
-                      *frat << implyxfromcls << XID << learnt_clause[0] << fratchain << ID << fin;
-                    unit_cl_XIDs[v] = XID;
-                }
-                enqueue<false>(learnt_clause[0], level, PropBy(), false);
+                enqueue_frat_unit(learnt_clause[0], ID, level);
             }
             break;
         case 2:
@@ -1757,7 +2016,7 @@ bool Searcher::handle_conflict(PropBy confl)
         verb_print(10, "find_conflict_level() gives 0, so UNSAT for whole formula. "
                 "decLevel: " << decisionLevel());
         if (unsat_cl_ID == 0) {
-            *frat << add << ++clauseID << fin;
+            frat_add_level0(++clauseID, lit_Undef, confl);
             set_unsat_cl_id(clauseID);
         }
         solver->ok = false;
@@ -1805,8 +2064,13 @@ bool Searcher::handle_conflict(PropBy confl)
         }
     }
 
+    if (rephase_enabled()) rephase_update_best();
+    if (polarity_mode == PolarityMode::polarmode_target) update_target_phases();
+
     // check chrono backtrack condition
     if (conf.diff_declev_for_chrono > -1
+        && conf.confl_to_chrono > -1
+        && sumConflicts >= (uint64_t)conf.confl_to_chrono
         && xorclauses.empty()
         && gmatrices.empty()
         && bnns.empty()
@@ -2059,6 +2323,21 @@ void Searcher::print_restart_stat()
         print_restart_stat_line();
         lastRestartPrint = sumConflicts;
     }
+    if (progress_cb) {
+        report_progress();
+    }
+}
+
+void Searcher::report_progress() const
+{
+    SolveProgress p;
+    p.conflicts = sumConflicts;
+    p.decisions = sumDecisions;
+    p.propagations = sumPropagations;
+    p.restarts = sumRestarts();
+    p.free_vars = solver->get_num_free_vars();
+    p.sls_best_cost = sls_best_cost;
+    progress_cb(p, progress_cb_data);
 }
 
 void Searcher::reset_temp_cl_num()
@@ -2205,9 +2484,85 @@ struct branch_type_total{
     string descr_short;
 };
 
+bool Searcher::mode_switch_enabled() const
+{
+    return conf.do_mode_switch
+        && conf.restartType == Restart::automatic
+        && conf.branch_strategy_setup.find("vmtf") != std::string::npos
+        && conf.branch_strategy_setup.find("vsids") != std::string::npos;
+}
+
+// Alternate between focused mode (VMTF, glue restarts, saved phases) and
+// stable mode (VSIDS, Luby restarts, target phases). A stable phase lasts as
+// long as the focused phase before it, and every focused phase is
+// conf.mode_switch_inc times longer than the previous one.
+void Searcher::switch_search_mode()
+{
+    if (mode_phase_len == 0) {
+        stable_mode = false;
+        mode_phase_len = conf.mode_switch_first;
+    } else {
+        stable_mode = !stable_mode;
+        if (!stable_mode) mode_phase_len = (double)mode_phase_len * conf.mode_switch_inc;
+        hist.swap_mode_hist();
+        stats.mode_switches++;
+    }
+    branch_strategy_change = std::min<uint64_t>(
+        sumConflicts + mode_phase_len, numeric_limits<uint32_t>::max());
+    branch_strategy_at++;
+
+    const auto old_branch_strategy = branch_strategy;
+    if (stable_mode) {
+        branch_strategy = branch::vsids;
+        branch_strategy_str = "VSIDS";
+        branch_strategy_str_short = "vs";
+        reset_target_phases();
+    } else {
+        branch_strategy = branch::vmtf;
+        branch_strategy_str = "VMTF";
+        branch_strategy_str_short = "vmt";
+    }
+    setup_restart_strategy(true);
+    polarity_strategy_change = 0;
+    setup_polarity_strategy();
+
+    verb_print(1, "[mode] switching to " << (stable_mode ? "stable" : "focused")
+        << " for " << mode_phase_len << " conflicts"
+        << " branch: " << branch_type_to_string(branch_strategy)
+        << " (from: " << branch_type_to_string(old_branch_strategy) << ")"
+        << " restart: " << restart_type_to_string(params.rest_type)
+        << " polar: " << polarity_mode_to_long_string(polarity_mode));
+}
+
+// Target phases: the phases of the largest conflict-free assignment since
+// the last restart. Vars outside of it keep their previous target.
+void Searcher::update_target_phases()
+{
+    assert(decisionLevel() > 0);
+    const uint32_t assigned = trail_lim[decisionLevel()-1];
+    if (assigned <= target_trail) return;
+
+    for(uint32_t i = 0; i < assigned; i++) {
+        const Lit l = trail[i].lit;
+        if (l == lit_Undef) continue;
+        varData[l.var()].target_polarity = !l.sign();
+    }
+    target_trail = assigned;
+}
+
+void Searcher::reset_target_phases()
+{
+    for(auto& v: varData) v.target_polarity = v.saved_polarity;
+    target_trail = 0;
+}
+
 void Searcher::setup_branch_strategy()
 {
     if (sumConflicts < branch_strategy_change) return;
+    if (mode_switch_enabled()) {
+        switch_search_mode();
+        return;
+    }
     branch_strategy_change += 5000;
     branch_strategy_change *= 1.1;
     branch_strategy_at++;
@@ -2351,7 +2706,8 @@ void Searcher::setup_polarity_strategy()
     polarity_strategy_change *= 1.01;
     polarity_strategy_at++;
 
-    if ((polarity_strategy_at % 8) == 0) {
+    //Rephasing keeps its own best/stable phases, don't wipe them
+    if ((polarity_strategy_at % 8) == 0 && !rephase_enabled()) {
         for(auto& v: varData) {
             unif_uint_dist(u, 1);
             v.best_polarity = u(mtrand);
@@ -2362,7 +2718,14 @@ void Searcher::setup_polarity_strategy()
 
     //Set to default first
     polarity_mode = conf.polarity_mode;
-    if (conf.polarity_mode == PolarityMode::polarmode_automatic) {
+    if (stable_mode && conf.polarity_mode == PolarityMode::polarmode_automatic
+        && mode_switch_enabled()
+    ) {
+        polarity_mode = PolarityMode::polarmode_target;
+    } else if (rephase_enabled()) {
+        //Saved phases, reset every now and then by rephase_if_needed()
+        polarity_mode = PolarityMode::polarmode_saved;
+    } else if (conf.polarity_mode == PolarityMode::polarmode_automatic) {
         longest_trail_ever_stable = 0;
 
         if ((polarity_strategy_at % 4) == 0) {
@@ -2390,7 +2753,6 @@ void Searcher::setup_polarity_strategy()
 void Searcher::sls_if_needed()
 {
     assert(okay());
-    assert(decisionLevel() == 0);
     if (conf.doSLS &&
         // If XORs are available, or there are BNNs, SLS will not work as intended
         // HOWEVER, it seems to STILL help, likely by setting values randomly
@@ -2398,18 +2760,102 @@ void Searcher::sls_if_needed()
 //         bnns.empty() &&
         sumConflicts > next_sls)
     {
-        SLS sls(solver);
-        const lbool ret = sls.run(num_sls_called);
+        assert(decisionLevel() == 0);
+        const lbool ret = solver->sls->run(num_sls_called);
         assert(ret != l_False);
         num_sls_called++;
         next_sls = sumConflicts + 44000.0*conf.global_next_multiplier;
     }
 }
 
+bool Searcher::rephase_enabled() const
+{
+    return conf.do_rephase && conf.polarity_mode == PolarityMode::polarmode_automatic;
+}
+
+// Remember the phases of the largest conflict-free assignment since the last
+// rephase, i.e. the trail below the current decision level
+void Searcher::rephase_update_best()
+{
+    assert(decisionLevel() > 0);
+    const uint32_t assigned = trail_lim[decisionLevel()-1];
+    if (assigned <= rephase_best_trail) return;
+
+    for(uint32_t i = 0; i < assigned; i++) {
+        const Lit l = trail[i].lit;
+        if (l == lit_Undef) continue;
+        varData[l.var()].best_polarity = !l.sign();
+    }
+    rephase_best_trail = assigned;
+}
+
+// Kissat/CaDiCaL-style rephasing: overwrite the saved phases on a
+// geometrically growing conflict schedule. First original then inverted,
+// afterwards cycling through best, walk, original, best, walk, inverted,
+// best, random.
+void Searcher::rephase_if_needed()
+{
+    if (!rephase_enabled()) return;
+    if (next_rephase == 0) {
+        rephase_delta = conf.rephase_first;
+        next_rephase = sumConflicts + rephase_delta;
+        return;
+    }
+    if (sumConflicts <= next_rephase) return;
+    assert(decisionLevel() == 0);
+
+    static const char schedule[] = "BWOBWIBR";
+    char type;
+    if (rephase_at == 0) type = 'O';
+    else if (rephase_at == 1) type = 'I';
+    else type = schedule[(rephase_at-2) % (sizeof(schedule)-1)];
+    if (type == 'W' && !conf.doSLS) type = 'B';
+    rephase_at++;
+
+    switch(type) {
+        case 'O':
+            for(auto& v: varData) v.saved_polarity = false;
+            break;
+        case 'I':
+            for(auto& v: varData) v.saved_polarity = true;
+            break;
+        case 'B':
+            for(auto& v: varData) v.saved_polarity = v.best_polarity;
+            break;
+        case 'W': {
+            //CCNR starts from the best phases, leaves its best in stable_polarity
+            const lbool ret = solver->sls->run(num_sls_called);
+            assert(ret != l_False);
+            num_sls_called++;
+            if (solver->sls->last_run_set_phases()) {
+                for(auto& v: varData) v.saved_polarity = v.stable_polarity;
+            } else {
+                //No walk happened (memout, too small), fall back to best
+                type = 'B';
+                for(auto& v: varData) v.saved_polarity = v.best_polarity;
+            }
+            break;
+        }
+        case 'R':
+            for(auto& v: varData) {
+                unif_uint_dist(u, 1);
+                v.saved_polarity = u(mtrand);
+            }
+            break;
+        default:
+            assert(false);
+    }
+    rephase_best_trail = 0;
+    if (polarity_mode == PolarityMode::polarmode_target) reset_target_phases();
+
+    rephase_delta = (double)rephase_delta * conf.rephase_inc;
+    next_rephase = sumConflicts + rephase_delta;
+    verb_print(2, "[rephase] type: " << type << " next in: " << rephase_delta << " conflicts");
+}
+
 bool Searcher::intree_if_needed()
 {
     assert(okay());
-    assert(decisionLevel() == 0);
     if (!xorclauses.empty() || !gmatrices.empty()) return okay();
 
     bool ret = okay();
@@ -2418,6 +2864,7 @@ bool Searcher::intree_if_needed()
     if (conf.doIntreeProbe && conf.doFindAndReplaceEqLits && !conf.never_stop_search &&
         sumConflicts > next_intree
     ) {
+        assert(decisionLevel() == 0);
         if (ret) ret &= solver->intree->intree_probe();
         if (ret) rebuildOrderHeap(); // Needed because intree may have replaced variables
         next_intree = sumConflicts + 65000.0*conf.global_next_multiplier;
@@ -2469,8 +2916,8 @@ bool Searcher::sub_str_with_bin_if_needed()
 
 lbool Searcher::distill_clauses_if_needed()
 {
-    assert(decisionLevel() == 0);
     if (conf.do_distill_clauses && sumConflicts > next_cls_distill) {
+        assert(decisionLevel() == 0);
         if (!solver->distill_long_cls->distill(true, false)) return l_False;
         next_cls_distill = sumConflicts + 15000.0*conf.global_next_multiplier;
     }
@@ -2478,10 +2925,25 @@ lbool Searcher::distill_clauses_if_needed()
     return l_Undef;
 }
 
+bool Searcher::vivify_learnt_if_needed()
+{
+    if (conf.do_vivify_learnt && sumConflicts > next_vivify_learnt) {
+        assert(decisionLevel() == 0);
+        const uint64_t spent = search_ticks - last_vivify_search_ticks;
+        const int64_t budget = std::max<int64_t>(
+            (double)spent*conf.vivify_learnt_effort, 500LL*1000LL);
+        if (!solver->distill_long_cls->vivify_learnt(budget)) return false;
+        last_vivify_search_ticks = search_ticks;
+        next_vivify_learnt = sumConflicts + conf.vivify_learnt_every*conf.global_next_multiplier;
+    }
+
+    return okay();
+}
+
 bool Searcher::full_probe_if_needed()
 {
-    assert(decisionLevel() == 0);
     if (conf.do_full_probe && !conf.never_stop_search && sumConflicts > next_full_probe) {
+        assert(decisionLevel() == 0);
         full_probe_iter++;
         if (!solver->full_probe(full_probe_iter % 2)) return false;
         next_full_probe = sumConflicts + 20000.0*conf.global_next_multiplier;
@@ -2515,8 +2977,10 @@ lbool Searcher::solve(const uint64_t _max_confls) {
 
     SLOW_DEBUG_DO(assert(fast_backw.fast_backw_on || solver->check_order_heap_sanity()));
     while(stats.conflicts < max_confl_per_search_solve_call && status == l_Undef) {
+        uint64_t start_ticks = ticks();
         if (!conf.never_stop_search &&
                 (distill_clauses_if_needed() == l_False
+                || !vivify_learnt_if_needed()
                 || !full_probe_if_needed()
                 || !distill_bins_if_needed()
                 || !sub_str_with_bin_if_needed()
@@ -2529,11 +2993,15 @@ lbool Searcher::solve(const uint64_t _max_confls) {
         }
         SLOW_DEBUG_DO(assert(solver->check_order_heap_sanity()));
         sls_if_needed();
+        rephase_if_needed();
+        search_inproc_ticks += ticks() - start_ticks;
 
         assert(watches.get_smudged_list().empty());
         params.clear();
         params.max_confl_to_do = max_confl_per_search_solve_call-stats.conflicts;
+        start_ticks = ticks();
         status = search();
+        search_ticks += ticks() - start_ticks;
         if (status == l_Undef) {
             setup_branch_strategy();
             setup_restart_strategy(false);
@@ -2546,6 +3014,15 @@ lbool Searcher::solve(const uint64_t _max_confls) {
     }
 
     end:
+    //The limits may have been hit right after a partial restart
+    if (status == l_Undef && decisionLevel() > 0) {
+        cancelUntil(0);
+        if (!propagate<false>().isnullptr()) {
+            assert(!frat->enabled() || unsat_cl_ID != 0);
+            ok = false;
+            status = l_False;
+        }
+    }
     finish_up_solve(status);
     return status;
 }
@@ -2588,6 +3065,10 @@ void Searcher::setup_restart_strategy(bool force)
     } else {
         if (branch_strategy == branch::vsids) restart_strategy_at = 2;
         if (branch_strategy == branch::vmtf) restart_strategy_at = (restart_strategy_at % 2);
+        if (mode_switch_enabled()) {
+            restart_strategy_at = stable_mode ? 1 : 0;
+            restart_strategy_change = branch_strategy_change;
+        }
 
         if (conf.restartType == Restart::glue) restart_strategy_at = 0;
         if (conf.restartType == Restart::luby) restart_strategy_at = 1;
@@ -2599,7 +3080,7 @@ void Searcher::setup_restart_strategy(bool force)
         } else if (restart_strategy_at == 1) {
             params.rest_type = Restart::luby;
             luby_loop_num = 0;
-            max_confl_this_restart = luby(2, luby_loop_num) * (double)conf.restart_first;
+            max_confl_this_restart = luby(2, luby_loop_num) * (double)luby_unit();
             luby_loop_num++;
         } else if (restart_strategy_at == 2) {
             params.rest_type = Restart::geom;
@@ -2628,7 +3109,7 @@ void Searcher::adjust_restart_strategy_cutoffs()
         //                        it's start at conf.restart_first and never
         //                        reset
         case Restart::luby:
-            max_confl_this_restart = luby(2, luby_loop_num) * (double)conf.restart_first;
+            max_confl_this_restart = luby(2, luby_loop_num) * (double)luby_unit();
             luby_loop_num++;
             break;
 
@@ -2702,6 +3183,95 @@ void Searcher::check_need_restart() {
     VERBOSE_DEBUG_DO(if (params.needToStopSearch) cout << "c needToStopSearch set" << endl);
 }
 
+// A partial restart leaves decision levels on the trail for the next
+// search(). Everything else Searcher::solve() may run between two search()
+// calls needs decision level 0, so check that none of it is due.
+bool Searcher::can_reuse_trail() const
+{
+    if (!conf.do_reuse_trail
+        || branch_strategy == branch::rand
+        || fast_backw.fast_backw_on
+        || !xorclauses.empty()
+        || !gmatrices.empty()
+        || !bnns.empty()
+    ) {
+        return false;
+    }
+
+    //Searcher::solve() is about to return
+    if (stats.conflicts >= max_confl_per_search_solve_call
+        || cpuTime() >= conf.maxTime
+        || must_interrupt_asap()
+    ) {
+        return false;
+    }
+
+    //Strategy changes, SLS, sync with other threads
+    if (sumConflicts >= branch_strategy_change
+        || sumConflicts >= restart_strategy_change
+        || sumConflicts >= polarity_strategy_change
+        || (conf.doSLS && sumConflicts > next_sls)
+        || (rephase_enabled() && sumConflicts > next_rephase)
+        || solver->datasync->sync_due()
+    ) {
+        return false;
+    }
+
+    //Inprocessing
+    if (!conf.never_stop_search && (
+        (conf.do_distill_clauses && sumConflicts > next_cls_distill)
+        || (conf.do_distill_clauses && sumConflicts > next_sub_str_with_bin)
+        || (conf.do_vivify_learnt && sumConflicts > next_vivify_learnt)
+        || (conf.do_full_probe && sumConflicts > next_full_probe)
+        || (conf.do_distill_bin_clauses && sumConflicts > next_bins_distill)
+        || (conf.doStrSubImplicit && sumConflicts > next_str_impl_with_impl)
+        || (conf.doIntreeProbe && conf.doFindAndReplaceEqLits && sumConflicts > next_intree)
+    )) {
+        return false;
+    }
+
+    return true;
+}
+
+// Trail reuse (van der Tak, Ramos, Heule): after backtracking to level 0, the
+// decisions that rank above the next decision candidate would be taken again,
+// in the same order. Returns the number of such levels.
+uint32_t Searcher::trail_reuse_level()
+{
+    uint32_t next = var_Undef;
+    if (branch_strategy == branch::vsids) {
+        //Assigned variables are re-inserted when unassigned, dropping them is fine
+        while (!order_heap_vsids.empty() && value(order_heap_vsids[0]) != l_Undef) {
+            order_heap_vsids.removeMin();
+        }
+        if (order_heap_vsids.empty()) return 0;
+        next = order_heap_vsids[0];
+    } else {
+        assert(branch_strategy == branch::vmtf);
+        next = vmtf_pick_var();
+        if (next == var_Undef) return 0;
+    }
+
+    uint32_t level = 0;
+    while (level < decisionLevel()) {
+        //Assumptions are always decided first
+        if (level < assumptions.size()) {
+            level++;
+            continue;
+        }
+
+        const uint32_t dec = trail[trail_lim[level]].lit.var();
+        assert(varData[dec].reason.isnullptr());
+        const bool ranks_above = (branch_strategy == branch::vsids)
+            ? var_act_vsids[dec] > var_act_vsids[next]
+            : vmtf_btab[dec] > vmtf_btab[next];
+        if (!ranks_above) break;
+        level++;
+    }
+
+    return level;
+}
+
 void Searcher::print_solution_varreplace_status() const
 {
     for(size_t var = 0; var < nVarsOuter(); var++) {
@@ -3014,11 +3584,12 @@ PropBy Searcher::propagate() {
                 const auto propby = varData[trail[i].lit.var()].reason;
                 if (propby.getType() == PropByType::xor_t) get_xor_reason(propby, ID);
             }
-            if (ret.getType() == PropByType::xor_t) get_xor_reason(ret, ID);
             // We need this check, because apparently GJ can set unsat during prop
             if (unsat_cl_ID == 0) {
-                *frat << add << ++clauseID << fin;
+                frat_add_level0(++clauseID, lit_Undef, ret);
                 set_unsat_cl_id(clauseID);
+            } else if (ret.getType() == PropByType::xor_t) {
+                get_xor_reason(ret, ID);
             }
         }
     }
@@ -3135,7 +3706,9 @@ inline void Searcher::update_polarities_on_backtrack(const uint32_t btlevel)
         longest_trail_ever_inv = trail.size();
     }
 
-    if (polarity_mode == PolarityMode::polarmode_saved) {
+    if (polarity_mode == PolarityMode::polarmode_saved
+        || polarity_mode == PolarityMode::polarmode_target
+    ) {
         for(uint32_t i = trail_lim[btlevel]; i < trail.size(); i++) {
             const auto t = trail[i];
             if (t.lit == lit_Undef) continue;
@@ -3249,6 +3822,7 @@ void Searcher::cancelUntil(uint32_t blevel)
 
 
             if (trail[i].lev <= blevel) {
+                varData[var].sublevel = j;
                 trail[j++] = trail[i];
             } else {
                 assigns[var] = l_Undef;
@@ -81,6 +81,11 @@ class Searcher : public HyperEngine
         uint64_t luby_loop_num = 0;
         void set_seed(const uint32_t seed);
 
+        //Effort in ticks (see PropEngine::inproc_ticks) spent in search(),
+        //and in the inprocessing that solve() interleaves with it
+        uint64_t search_ticks = 0;
+        uint64_t search_inproc_ticks = 0;
+
 
         vector<lbool>  model;
         vector<Lit>   conflict;     ///<If problem is unsatisfiable (possibly under assumptions), this vector represent the final conflict clause expressed in the assumptions.
@@ -93,6 +98,9 @@ class Searcher : public HyperEngine
         uint64_t lastRestartPrint = 0;
         uint64_t lastRestartPrintHeader = 0;
         void     print_restart_stat();
+        progress_cb_t progress_cb = nullptr;
+        void*    progress_cb_data = nullptr;
+        void     report_progress() const;
         void     print_iteration_solving_stats();
         void     print_restart_header();
         void     print_restart_stat_line() const;
@@ -128,8 +136,8 @@ class Searcher : public HyperEngine
         void cancelUntil(uint32_t level); ///<Backtrack until a certain level.
         void cancelUntil_light();
         ConflictData find_conflict_level(PropBy& pb);
-        uint32_t chrono_backtrack = 0;
-        uint32_t non_chrono_backtrack = 0;
+        uint64_t chrono_backtrack = 0;
+        uint64_t non_chrono_backtrack = 0;
         void consolidate_watches(const bool full);
 
         //Gauss
@@ -156,6 +164,17 @@ class Searcher : public HyperEngine
             vector<Lit>& out_learnt,
             bool True_confl
         );
+        void chain_from_trail(
+            const vector<Lit>& cl,
+            const Lit* lits,
+            const uint32_t size,
+            const int32_t ID
+        );
+        void chain_from_trail(
+            const vector<Lit>& cl,
+            const PropBy confl,
+            const Lit bin_lit
+        );
         template<class T> void print_clause(const string& str, const T& cl) const;
 
         #ifdef STATS_NEEDED
@@ -185,6 +204,15 @@ class Searcher : public HyperEngine
         uint32_t branch_strategy_change = 0;
         uint32_t branch_strategy_at = 0;
         void setup_branch_strategy();
+
+        //Focused (VMTF, glue restarts) vs stable (VSIDS, Luby, target phases)
+        bool stable_mode = false;
+        uint64_t mode_phase_len = 0;
+        uint32_t target_trail = 0;
+        bool mode_switch_enabled() const;
+        void switch_search_mode();
+        void update_target_phases();
+        void reset_target_phases();
         void rebuildOrderHeap();
         void rebuildOrderHeapVMTF(vector<uint32_t>& vs);
         void print_order_heap();
@@ -215,6 +243,11 @@ class Searcher : public HyperEngine
         // Distill
         uint64_t next_cls_distill = 0;
         lbool distill_clauses_if_needed();
+
+        // Vivify tier-0/tier-1 learnt clauses
+        uint64_t next_vivify_learnt = 0;
+        uint64_t last_vivify_search_ticks = 0;
+        bool vivify_learnt_if_needed();
         uint64_t next_bins_distill = 0;
         bool distill_bins_if_needed();
 
@@ -239,6 +272,15 @@ class Searcher : public HyperEngine
         uint64_t next_sls = 0;
         void sls_if_needed();
 
+        // Rephasing
+        uint64_t next_rephase = 0;
+        uint64_t rephase_delta = 0;
+        uint32_t rephase_at = 0;
+        uint32_t rephase_best_trail = 0;
+        bool rephase_enabled() const;
+        void rephase_if_needed();
+        void rephase_update_best();
+
         // Fast backward for Arjun
         lbool new_decision_fast_backw();
         void create_new_fast_backw_assumption();
@@ -362,11 +404,16 @@ class Searcher : public HyperEngine
         int64_t increasing_phase_size;
         int64_t max_confl_this_restart;
         void  check_need_restart();
+        bool  can_reuse_trail() const;
+        uint32_t trail_reuse_level();
         void  check_blocking_restart();
         bool blocked_restart = false;
         uint64_t max_confl_per_search_solve_call;
         uint32_t num_search_called = 0;
         double luby(double y, int x);
+        uint32_t luby_unit() const {
+            return stable_mode ? conf.restart_first_stable : conf.restart_first;
+        }
         CMSat::Restart cur_rest_type;
         uint32_t restart_strategy_change = 0;
         uint32_t restart_strategy_at = 0;
@@ -390,6 +437,9 @@ class Searcher : public HyperEngine
         bool litRedundant(Lit p, uint32_t abstract_levels);
         void recursiveConfClauseMin();
         void normalClMinim();
+        void shrink_learnt_clause();
+        Lit shrink_block(const uint32_t begin, const uint32_t end, const uint32_t level);
+        vector<uint32_t> shrink_marked;
         MyStack<Lit> analyze_stack;
         uint32_t abstractLevel(const uint32_t x) const;
         bool subset(const vector<Lit>& A, const Clause& B); //Used for on-the-fly subsumption. Does A subsume B? Uses 'seen' to do its work
@@ -589,6 +639,9 @@ inline bool Searcher::pick_polarity(const uint32_t var)
         case PolarityMode::polarmode_saved:
             return varData[var].saved_polarity;
 
+        case PolarityMode::polarmode_target:
+            return varData[var].target_polarity;
+
         #ifdef WEIGHTED_SAMPLING
         case PolarityMode::polarmode_weighted: {
             double rnd = mtrand.randDblExc();
@@ -65,6 +65,18 @@ struct SearchHist {
     bqueue<uint32_t>    trailDepthHist;
     #endif
 
+    //Long-term restart averages of the search mode (focused/stable)
+    //that is not running right now. Swapped in at mode switch.
+    AvgCalc<uint32_t>   other_glueHistLTLimited;
+    bqueue<uint32_t>    other_trailDepthHistLonger;
+
+    void swap_mode_hist()
+    {
+        std::swap(glueHistLTLimited, other_glueHistLTLimited);
+        std::swap(trailDepthHistLonger, other_trailDepthHistLonger);
+        glueHist.clear();
+    }
+
     size_t mem_used() const
     {
         uint64_t used = sizeof(SearchHist);
@@ -74,6 +86,7 @@ struct SearchHist {
         used += sizeof(AvgCalc<double, double>)*2;
         used += glueHist.usedMem();
         used += trailDepthHistLonger.usedMem();
+        used += other_trailDepthHistLonger.usedMem();
         #if defined(STATS_NEEDED) || defined(FINAL_PREDICTOR)
         used += backtrackLevelHist.usedMem();
         used += branchDepthHistQueue.usedMem();
@@ -115,6 +128,7 @@ struct SearchHist {
     {
         glueHist.clearAndResize(shortTermHistorySize);
         trailDepthHistLonger.clearAndResize(blocking_trail_hist_size);
+        other_trailDepthHistLonger.clearAndResize(blocking_trail_hist_size);
         #if defined(STATS_NEEDED) || defined(FINAL_PREDICTOR)
         backtrackLevelHist.clearAndResize(shortTermHistorySize);
         trailDepthHist.clearAndResize(shortTermHistorySize);
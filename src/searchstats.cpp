@@ -27,8 +27,11 @@ using namespace CMSat;
 SearchStats& SearchStats::operator+=(const SearchStats& other)
 {
     numRestarts += other.numRestarts;
+    partialRestarts += other.partialRestarts;
+    reusedLevels += other.reusedLevels;
     blocked_restart += other.blocked_restart;
     blocked_restart_same += other.blocked_restart_same;
+    mode_switches += other.mode_switches;
 
     //Decisions
     decisions += other.decisions;
@@ -45,6 +48,10 @@ SearchStats& SearchStats::operator+=(const SearchStats& other)
     permDiff_attempt  += other.permDiff_attempt;
     permDiff_rem_lits += other.permDiff_rem_lits;
     permDiff_success += other.permDiff_success;
+    shrinkBlocks += other.shrinkBlocks;
+    shrinkBlocksOK += other.shrinkBlocksOK;
+    shrinkLitRem += other.shrinkLitRem;
+    glueFinal += other.glueFinal;
 
     furtherShrinkAttempt  += other.furtherShrinkAttempt;
     binTriShrinkedClause += other.binTriShrinkedClause;
@@ -85,8 +92,11 @@ SearchStats& SearchStats::operator+=(const SearchStats& other)
 SearchStats& SearchStats::operator-=(const SearchStats& other)
 {
     numRestarts -= other.numRestarts;
+    partialRestarts -= other.partialRestarts;
+    reusedLevels -= other.reusedLevels;
     blocked_restart -= other.blocked_restart;
     blocked_restart_same -= other.blocked_restart_same;
+    mode_switches -= other.mode_switches;
 
     //Decisions
     decisions -= other.decisions;
@@ -103,6 +113,10 @@ SearchStats& SearchStats::operator-=(const SearchStats& other)
     permDiff_attempt  -= other.permDiff_attempt;
     permDiff_rem_lits -= other.permDiff_rem_lits;
     permDiff_success -= other.permDiff_success;
+    shrinkBlocks -= other.shrinkBlocks;
+    shrinkBlocksOK -= other.shrinkBlocksOK;
+    shrinkLitRem -= other.shrinkLitRem;
+    glueFinal -= other.glueFinal;
 
     furtherShrinkAttempt  -= other.furtherShrinkAttempt;
     binTriShrinkedClause -= other.binTriShrinkedClause;
@@ -160,6 +174,16 @@ void SearchStats::printCommon(uint64_t props, bool do_print_times) const
         , "per normal restart"
 
     );
+    print_stats_line("c partial restarts"
+        , partialRestarts
+        , float_div(reusedLevels, partialRestarts)
+        , "levels kept per partial restart"
+    );
+    print_stats_line("c search mode switches"
+        , mode_switches
+        , float_div(conflicts, mode_switches)
+        , "confls per mode"
+    );
     if (do_print_times)
     print_stats_line("c time", cpu_time);
     print_stats_line("c decisions", decisions
@@ -192,6 +216,16 @@ void SearchStats::print_short(uint64_t props, bool do_print_times) const
         , float_div(litsRedFinal, conflicts)
     );
 
+    print_stats_line("c conf glue final"
+        , float_div(glueFinal, conflicts)
+    );
+
+    print_stats_line("c shrink lits-rem"
+        , shrinkLitRem
+        , stats_line_percent(shrinkLitRem, litsRedNonMin)
+        , "% less overall"
+    );
+
     print_stats_line("c red which0"
         , red_cl_in_which0
         , stats_line_percent(red_cl_in_which0, conflicts)
@@ -281,6 +315,18 @@ void SearchStats::print(uint64_t props, bool do_print_times) const
         , "less lits/cl on attempts"
      );
 
+    print_stats_line("c shrink blocks"
+        , shrinkBlocks
+        , stats_line_percent(shrinkBlocksOK, shrinkBlocks)
+        , "% replaced by UIP"
+    );
+
+    print_stats_line("c shrink lits-rem"
+        , shrinkLitRem
+        , stats_line_percent(shrinkLitRem, litsRedNonMin)
+        , "% less overall"
+    );
+
 
     print_stats_line("c further-min call%"
         , stats_line_percent(furtherShrinkAttempt, conflicts)
@@ -298,6 +344,10 @@ void SearchStats::print(uint64_t props, bool do_print_times) const
         , ratio_for_stat(litsRedFinal, conflicts)
     );
 
+    print_stats_line("c final avg glue"
+        , ratio_for_stat(glueFinal, conflicts)
+    );
+
     //General stats
     //print_stats_line("c Memory used", (double)mem_used / 1048576.0, " MB");
     #if !defined(_MSC_VER) && defined(RUSAGE_THREAD)
@@ -49,7 +49,10 @@ public:
     //Restart stats
     uint64_t blocked_restart = 0;
     uint64_t blocked_restart_same = 0;
+    uint64_t mode_switches = 0;
     uint64_t numRestarts = 0;
+    uint64_t partialRestarts = 0;
+    uint64_t reusedLevels = 0;
 
     //Decisions
     uint64_t  decisions = 0;
@@ -65,6 +68,10 @@ public:
     uint64_t permDiff_attempt = 0;
     uint64_t permDiff_success = 0;
     uint64_t permDiff_rem_lits = 0;
+    uint64_t shrinkBlocks = 0;
+    uint64_t shrinkBlocksOK = 0;
+    uint64_t shrinkLitRem = 0;
+    uint64_t glueFinal = 0;
 
     uint64_t furtherShrinkAttempt = 0;
     uint64_t binTriShrinkedClause = 0;
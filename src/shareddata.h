@@ -28,6 +28,8 @@ THE SOFTWARE.
 #include <vector>
 #include <mutex>
 #include <atomic>
+#include <limits>
+#include <utility>
 using std::vector;
 using std::mutex;
 
@@ -36,7 +38,10 @@ namespace CMSat {
 class SharedData
 {
     public:
-        SharedData(const uint32_t _num_threads) : num_threads(_num_threads) { cur_thread_id.store(0); }
+        SharedData(const uint32_t _num_threads) : num_threads(_num_threads) {
+            cur_thread_id.store(0);
+            frat_pool_ID.store(0);
+        }
         ~SharedData() {}
 
         struct Spec {
@@ -67,11 +72,29 @@ class SharedData
         std::atomic<int> cur_thread_id;
         uint32_t num_threads;
 
+        //Best SLS assignment any thread found, indexed by outer var
+        vector<lbool> sls_phase;
+        int64_t sls_phase_cost = -1;
+        uint64_t sls_phase_gen = 0;
+        int sls_phase_thread = -1;
+        std::mutex sls_phase_mutex;
+
+        //FRAT: all threads write into the same proof file, through the
+        //ProofWriter if there is one, otherwise under frat_mutex.
+        //Units and binaries handed between threads are first copied into
+        //the proof as clauses of their own (the "pool"), which no thread
+        //ever deletes, so importers can derive their copy from them.
+        std::mutex frat_mutex;
+        std::atomic<int32_t> frat_pool_ID;
+        int32_t frat_pool_ID_end = std::numeric_limits<int32_t>::max();
+        vector<std::pair<int32_t, vector<Lit>>> frat_pool; //outer lits
+
         size_t calc_memory_use_bins()
         {
             size_t mem = 0;
             mem += value.capacity()*sizeof(lbool);
             mem += bins.capacity()*sizeof(Spec);
+            mem += sls_phase.capacity()*sizeof(lbool);
             for(size_t i = 0; i < bins.size(); i++) {
                 if (bins[i].data) {
                     mem += bins[i].data->capacity()*sizeof(Lit);
@@ -31,22 +31,31 @@ SLS::SLS(Solver* _solver) :
 {}
 
 SLS::~SLS()
-{}
+{
+    delete ccnr;
+}
 
 lbool SLS::run(const uint32_t num_sls_called)
 {
     return run_ccnr(num_sls_called);
 }
 
+bool SLS::last_run_set_phases() const
+{
+    return ccnr && ccnr->phases_set;
+}
+
 lbool SLS::run_ccnr(const uint32_t num_sls_called)
 {
-    CMS_ccnr ccnr(solver);
     double mem_needed_mb = (double)approx_mem_needed()/(1000.0*1000.0);
     double maxmem = solver->conf.sls_memoutMB*solver->conf.var_and_mem_out_mult;
     if (mem_needed_mb < maxmem) {
-        lbool ret = ccnr.main(num_sls_called);
+        if (!ccnr) ccnr = new CMS_ccnr(solver);
+        lbool ret = ccnr->main(num_sls_called);
         return ret;
     }
+    delete ccnr;
+    ccnr = nullptr;
 
     verb_print(1, "[sls] would need "
         << std::setprecision(2) << std::fixed << mem_needed_mb
@@ -58,42 +67,33 @@ lbool SLS::run_ccnr(const uint32_t num_sls_called)
 
 uint64_t SLS::approx_mem_needed()
 {
-    uint32_t numvars = solver->nVars();
-    uint32_t numclauses = solver->longIrredCls.size() + solver->binTri.irredBins;
+    uint64_t numvars = solver->nVars();
+    uint64_t numclauses = solver->longIrredCls.size() + solver->binTri.irredBins;
     uint64_t numliterals = solver->litStats.irredLits + solver->binTri.irredBins*2;
     uint64_t needed = 0;
 
-    //LIT storage (all clause data)
-    needed += (solver->litStats.irredLits+solver->binTri.irredBins*2)*sizeof(Lit);
-
-    //This is just an estimation of yalsat's memory needs.
-
-    //clause
-    needed += sizeof(Lit *) * numclauses;
-    //clsize
-    needed += sizeof(uint32_t) * numclauses;
-
-    //false_cls
-    needed += sizeof(uint32_t) * numclauses;
-    //map_cl_to_false_cls
-    needed += sizeof(uint32_t) * numclauses;
-    //numtruelit
-    needed += sizeof(uint32_t) * numclauses;
-
-    //occurrence
-    needed += sizeof(uint32_t *) * (2 * numvars);
-    //numoccurrence
-    needed += sizeof(uint32_t) * (2 * numvars);
-    //assigns
-    needed += sizeof(lbool) * numvars;
-    //breakcount
-    needed += sizeof(uint32_t) * numvars;
-    //makecount
-    needed += sizeof(uint32_t) * numvars;
-
-    //occur_list_alloc
-    needed += sizeof(uint32_t) * numliterals;
-
+    //CCNR keeps the formula in flat CSR arrays: clause->lits, var->occurrences
+    needed += sizeof(CCNR::lit) * numliterals;
+    needed += sizeof(CCNR::occ) * numliterals;
+    needed += sizeof(uint32_t) * (numclauses + numvars);
+
+    //Every walker has its own: clause data, unsat clause list and its index,
+    //var data, solution, best solution, unsat var list and its index,
+    //ccd vars, conflict count
+    uint64_t per_walker = 0;
+    per_walker += (sizeof(CCNR::clause) + 2*sizeof(int)) * numclauses;
+    per_walker += (sizeof(CCNR::variable) + 2*sizeof(uint8_t) + 4*sizeof(int)) * numvars;
+    needed += per_walker * std::max<uint32_t>(solver->conf.sls_walkers, 1);
+
+    //neighbourhood, only stored if small enough
+    uint64_t neighbors = solver->binTri.irredBins*2;
+    for(ClOffset offs: solver->longIrredCls) {
+        const uint64_t sz = solver->cl_alloc.ptr(offs)->size();
+        neighbors += sz*(sz-1);
+    }
+    if (neighbors <= CCNR::formula::max_neighbor_entries) {
+        needed += sizeof(uint32_t) * (neighbors + numvars);
+    }
 
     return needed;
 }
@@ -28,15 +28,18 @@ THE SOFTWARE.
 namespace CMSat {
 
 class Solver;
+class CMS_ccnr;
 
 class SLS {
 public:
     SLS(Solver* solver);
     ~SLS();
     lbool run(const uint32_t num_sls_called);
+    bool last_run_set_phases() const;
 
 private:
     Solver* solver;
+    CMS_ccnr* ccnr = nullptr; //kept between calls, re-synced incrementally
 
     lbool run_ccnr(const uint32_t num_sls_called);
     uint64_t approx_mem_needed();
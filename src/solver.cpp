@@ -56,6 +56,7 @@ THE SOFTWARE.
 #include "subsumeimplicit.h"
 #include "distillerlongwithimpl.h"
 #include "str_impl_w_impl.h"
+#include "inprocsched.h"
 #include "datasync.h"
 #include "reducedb.h"
 #include "sccfinder.h"
@@ -120,6 +121,8 @@ Solver::Solver(const SolverConf *_conf, std::atomic<bool>* _must_interrupt_inter
     distill_lit_rem = new DistillerLitRem(this);
     dist_long_with_impl = new DistillerLongWithImpl(this);
     dist_impl_with_impl = new StrImplWImpl(this);
+    inproc_sched = new InprocSched(this);
+    sls = new SLS(this);
     clauseCleaner = new ClauseCleaner(this);
     varReplacer = new VarReplacer(this);
     if (conf.doStrSubImplicit) {
@@ -149,6 +152,8 @@ Solver::~Solver()
     delete distill_bin_cls;
     delete dist_long_with_impl;
     delete dist_impl_with_impl;
+    delete inproc_sched;
+    delete sls;
     delete clauseCleaner;
     delete varReplacer;
     delete subsumeImplicit;
@@ -304,6 +309,8 @@ This code is very specific in that it must NOT be called with variables in
 when the wer are in an UNSAT (!ok) state, for example. Use it carefully,
 and only internally
 
+If frat_chain is set, "chain" holds the hints the clause is derived with
+
 Deals with INTERNAL variables
 */
 Clause* Solver::add_clause_int(
@@ -316,6 +323,7 @@ Clause* Solver::add_clause_int(
     , const Lit frat_first
     , const bool sorted
     , const bool remove_frat
+    , const bool frat_chain
 ) {
     assert(okay());
     assert(decisionLevel() == 0);
@@ -342,7 +350,9 @@ Clause* Solver::add_clause_int(
         ID = cl_stats->ID;
         if (ps != lits) {
             ID = ++clauseID;
-            *frat << add << ID << ps << fin;
+            *frat << add << ID << ps << fratchain;
+            for(const Lit l: lits) if (value(l) == l_False) *frat << unit_cl_IDs[l.var()];
+            *frat << cl_stats->ID << fin;
             *frat << del << cl_stats->ID << lits << fin;
         }
     } else {
@@ -359,7 +369,9 @@ Clause* Solver::add_clause_int(
                 std::swap(ps[0], ps[i]);
             }
 
-            *frat << add << ID << ps << fin;
+            *frat << add << ID << ps;
+            if (frat_chain) add_chain();
+            *frat << fin;
             if (frat_first != lit_Undef) {
                 std::swap(ps[0], ps[i]);
             }
@@ -378,8 +390,13 @@ Clause* Solver::add_clause_int(
             return nullptr;
         case 1:
             assert(decisionLevel() == 0);
-            enqueue<false>(ps[0]);
-            *frat << del << ID << ps[0] << fin; // double unit delete
+            if (add_frat && frat->enabled() && !frat->incremental()) {
+                //The clause itself is the unit's FRAT clause, no need to re-add
+                enqueue_frat_unit(ps[0], ID, decisionLevel());
+            } else {
+                enqueue<false>(ps[0]);
+                *frat << del << ID << ps[0] << fin; // double unit delete
+            }
             if (attach_long) ok = (propagate<true>().isnullptr());
             return nullptr;
         case 2:
@@ -1402,7 +1419,8 @@ lbool Solver::solve_with_assumptions(
     ) {
         status = simplify_problem(
             !conf.full_simplify_at_startup,
-            !conf.full_simplify_at_startup ? conf.simplify_schedule_startup : conf.simplify_schedule_nonstartup);
+            !conf.full_simplify_at_startup ? conf.simplify_schedule_startup : conf.simplify_schedule_nonstartup,
+            true);
     }
 
     #ifdef STATS_NEEDED
@@ -1651,7 +1669,7 @@ lbool Solver::iterate_until_solved() {
         ) break;
 
         if (conf.do_simplify_problem) {
-            status = simplify_problem(false, conf.simplify_schedule_nonstartup);
+            status = simplify_problem(false, conf.simplify_schedule_nonstartup, true);
         }
     }
 
@@ -1722,7 +1740,9 @@ void Solver::handle_found_solution(const lbool status, const bool only_sampling_
 lbool Solver::execute_inprocess_strategy(
     const bool startup
     , const string& strategy
+    , const bool adaptive
 ) {
+    const bool sched = adaptive && conf.adaptive_sched;
     std::istringstream ss(strategy + ", ");
     std::string token;
     std::string occ_strategy_tokens;
@@ -1752,8 +1772,11 @@ lbool Solver::execute_inprocess_strategy(
         if (!occ_strategy_tokens.empty() && token.substr(0,3) != "occ") {
             if (conf.perform_occur_based_simp && bnns.empty() && occsimplifier) {
                 occ_strategy_tokens = trim(occ_strategy_tokens);
-                verb_print(1, "Executing OCC strategy token(s): '" << occ_strategy_tokens);
-                occsimplifier->simplify(startup, occ_strategy_tokens);
+                if (!sched || inproc_sched->begin(occ_strategy_tokens)) {
+                    verb_print(1, "Executing OCC strategy token(s): '" << occ_strategy_tokens);
+                    occsimplifier->simplify(startup, occ_strategy_tokens);
+                    if (sched) inproc_sched->end();
+                }
             }
             occ_strategy_tokens.clear();
             if (sumConflicts >= conf.max_confl || cpuTime() > conf.maxTime
@@ -1765,8 +1788,10 @@ lbool Solver::execute_inprocess_strategy(
         }
         if (okay()) SLOW_DEBUG_DO(check_wrong_attach());
 
-        if (token.substr(0,3) != "occ" && !token.empty())
+        if (token.substr(0,3) != "occ" && !token.empty()) {
+            if (sched && !inproc_sched->begin(token)) continue;
             verb_print(1, "--> Executing strategy token: " << token);
+        }
 
         if (token == "scc-vrepl") {
             if (conf.doFindAndReplaceEqLits) {
@@ -1794,7 +1819,7 @@ lbool Solver::execute_inprocess_strategy(
                 varReplacer->replace_if_enough_is_found();
             }
         } else if (token == "full-probe") {
-            if (!full_probe(false)) return l_False;
+            full_probe(false);
         } else if (token == "card-find") {
             if (conf.doFindCard) {
                 card_finder->find_cards();
@@ -1916,6 +1941,7 @@ lbool Solver::execute_inprocess_strategy(
             cout << "ERROR: strategy '" << token << "' not recognised!" << endl;
             exit(-1);
         }
+        if (sched) inproc_sched->end();
 
         SLOW_DEBUG_DO(check_stats());
         if (!okay()) return l_False;
@@ -1930,7 +1956,9 @@ lbool Solver::execute_inprocess_strategy(
 /**
 @brief The function that brings together almost all CNF-simplifications
 */
-lbool Solver::simplify_problem(const bool startup, const string& strategy) {
+lbool Solver::simplify_problem(
+    const bool startup, const string& strategy, const bool adaptive)
+{
     assert(okay());
     verb_print(6,  __func__ << " called");
     DEBUG_IMPLICIT_STATS_DO(check_stats());
@@ -1949,19 +1977,14 @@ lbool Solver::simplify_problem(const bool startup, const string& strategy) {
     clear_order_heap();
     if (!clear_gauss_matrices(false)) return l_False;
 
-    if (ret == l_Undef) ret = execute_inprocess_strategy(startup, strategy);
+    const uint64_t start_ticks = ticks();
+    if (ret == l_Undef) ret = execute_inprocess_strategy(startup, strategy, adaptive);
     assert(ret != l_True);
 
     //Free unused watch memory
     free_unused_watches();
 
-    conf.global_timeout_multiplier *= conf.global_timeout_multiplier_multiplier;
-    conf.global_timeout_multiplier =
-        std::min<double>(
-            conf.global_timeout_multiplier,
-            conf.orig_global_timeout_multiplier*conf.global_multiplier_multiplier_max
-        );
-    verb_print(1, "global_timeout_multiplier: " << std::setprecision(4) <<  conf.global_timeout_multiplier);
+    update_timeout_multiplier(adaptive, ticks() - start_ticks);
 
     solveStats.num_simplify++;
     solveStats.num_simplify_this_solve_call++;
@@ -1985,6 +2008,32 @@ lbool Solver::simplify_problem(const bool startup, const string& strategy) {
     return ret;
 }
 
+// When called from solve(), the multiplier is steered so that inprocessing
+// gets conf.inprocess_effort_ratio of the effort search got since the last
+// simplification. Otherwise it is simply increased every time.
+void Solver::update_timeout_multiplier(const bool adaptive, const uint64_t round_ticks)
+{
+    const double max_mult = conf.orig_global_timeout_multiplier*conf.global_multiplier_multiplier_max;
+    const uint64_t search = search_ticks - last_mult_search_ticks;
+    if (!adaptive || conf.inprocess_effort_ratio <= 0 || search == 0) {
+        conf.global_timeout_multiplier *= conf.global_timeout_multiplier_multiplier;
+        conf.global_timeout_multiplier = std::min<double>(conf.global_timeout_multiplier, max_mult);
+    } else {
+        const uint64_t inproc = search_inproc_ticks - last_mult_search_inproc_ticks + round_ticks;
+        const double factor = conf.inprocess_effort_ratio*(double)search/(double)std::max<uint64_t>(inproc, 1);
+        conf.global_timeout_multiplier *= std::clamp(factor, 0.5, 2.0);
+        conf.global_timeout_multiplier = std::clamp(conf.global_timeout_multiplier,
+            conf.orig_global_timeout_multiplier/conf.global_multiplier_multiplier_max, max_mult);
+        verb_print(1, "[ticks] search: " << print_value_kilo_mega(search)
+            << " inprocess: " << print_value_kilo_mega(inproc)
+            << " ratio: " << std::setprecision(3) << float_div(inproc, search)
+            << " target: " << conf.inprocess_effort_ratio);
+    }
+    last_mult_search_ticks = search_ticks;
+    last_mult_search_inproc_ticks = search_inproc_ticks;
+    verb_print(1, "global_timeout_multiplier: " << std::setprecision(4) <<  conf.global_timeout_multiplier);
+}
+
 void CMSat::Solver::print_stats(
     const double cpu_time,
     const double cpu_time_total,
@@ -2036,6 +2085,11 @@ void Solver::print_norm_stats(
     print_stats_line("c props/conflict"
         , float_div(propStats.propagations, sumConflicts)
     );
+    print_stats_line("c chrono backtracks"
+        , chrono_backtrack
+        , stats_line_percent(chrono_backtrack, chrono_backtrack+non_chrono_backtrack)
+        , "% of backtracks"
+    );
 
     print_stats_line("c 0-depth assigns", trail.size()
         , stats_line_percent(trail.size(), nVars())
@@ -2078,6 +2132,17 @@ void Solver::print_norm_stats(
                     , stats_line_percent(distill_long_cls->get_stats().time_used, cpu_time)
                     , "% time"
     );
+    print_stats_line("c vivif learnt time"
+                    , distill_long_cls->get_viv_stats().time_used
+                    , stats_line_percent(distill_long_cls->get_viv_stats().time_used, cpu_time)
+                    , "% time"
+    );
+    print_stats_line("c vivif learnt shortened"
+                    , distill_long_cls->get_viv_stats().numClShorten
+                    , stats_line_percent(distill_long_cls->get_viv_stats().numClShorten
+                        , distill_long_cls->get_viv_stats().checkedClauses)
+                    , "% of tried"
+    );
     print_stats_line("c distill bin time"
                     , distill_bin_cls->get_stats().time_used
                     , stats_line_percent(distill_bin_cls->get_stats().time_used, cpu_time)
@@ -2126,6 +2191,7 @@ void Solver::print_norm_stats(
     } else {
         print_stats_line("c Conflicts in UIP", sumConflicts);
     }
+    if (frat->enabled()) frat->print_stats();
     double vm_usage;
     std::string max_mem_usage;
     double max_rss_mem_mb = (double)memUsedTotal(vm_usage, &max_mem_usage)/(1024UL*1024UL);
@@ -2176,6 +2242,7 @@ void Solver::print_full_stats(
     if (conf.doStrSubImplicit) {
         subsumeImplicit->get_stats().print("");
     }
+    if (conf.adaptive_sched) inproc_sched->print_stats();
     print_mem_stats();
 }
 
@@ -2747,6 +2814,43 @@ bool Solver::add_clause_outside(const vector<Lit>& lits, bool red, bool restore)
     return add_clause_outer(tmp, lits, red, restore);
 }
 
+// Adds clauses from a flat buffer where each clause is terminated by
+// lit_Undef (or 0 in the DIMACS-style case). The temporaries are re-used
+// across clauses, so no allocation takes place per clause.
+template<class T>
+bool Solver::add_clauses_outside_flat(const T* lits, const size_t num_lits)
+{
+    size_t at = 0;
+    while(at < num_lits) {
+        add_cls_tmp.clear();
+        for(; at < num_lits && !is_flat_cl_end(lits[at]); at++) {
+            add_cls_tmp.push_back(flat_to_lit(lits[at]));
+        }
+        at++; //skip terminator
+
+        if (!ok || frat->enabled()) {
+            //Slow path, takes care of FRAT/IDRUP logging, which needs the
+            //original clause next to the one being rewritten
+            add_clause_outside(add_cls_tmp);
+            continue;
+        }
+        SLOW_DEBUG_DO(check_too_large_variable_number(add_cls_tmp));
+        //Without a proof the original is not needed, rewrite in place
+        add_clause_outer(add_cls_tmp, add_cls_tmp);
+    }
+    return ok;
+}
+
+bool Solver::add_clauses_outside(const Lit* lits, const size_t num_lits)
+{
+    return add_clauses_outside_flat(lits, num_lits);
+}
+
+bool Solver::add_clauses_outside(const int32_t* lits, const size_t num_lits)
+{
+    return add_clauses_outside_flat(lits, num_lits);
+}
+
 bool Solver::add_xor_clause_outside(const vector<Lit>& lits_out, bool rhs) {
     frat_func_start();
     if (!okay()) return false;
@@ -3701,6 +3805,9 @@ void Solver::detach_clauses_in_xors() {
 
 void Solver::conclude_idrup (lbool result)
 {
+    //FRAT has no conclusion lines, and FratFile can't write them
+    if (!frat->incremental()) return;
+
     if (result == l_True) {
       *frat << satisfiable;
       *frat << modelF;
@@ -63,6 +63,8 @@ class DistillerBin;
 class DistillerLitRem;
 class DistillerLongWithImpl;
 class StrImplWImpl;
+class InprocSched;
+class SLS;
 class CalcDefPolars;
 class SolutionExtender;
 class CardFinder;
@@ -94,6 +96,8 @@ class Solver : public Searcher
         void new_external_var();
         void new_external_vars(size_t n);
         bool add_clause_outside(const vector<Lit>& lits, bool red = false, bool restore = false);
+        bool add_clauses_outside(const Lit* lits, const size_t num_lits); //each clause terminated by lit_Undef
+        bool add_clauses_outside(const int32_t* lits, const size_t num_lits); //DIMACS-style, each clause terminated by 0
         bool add_xor_clause_outside(const vector<uint32_t>& vars, const bool rhs);
         bool add_xor_clause_outside(const vector<Lit>& lits_out, bool rhs);
         bool add_bnn_clause_outside(
@@ -194,6 +198,8 @@ class Solver : public Searcher
         DistillerLitRem*       distill_lit_rem = nullptr;
         DistillerLongWithImpl* dist_long_with_impl = nullptr;
         StrImplWImpl* dist_impl_with_impl = nullptr;
+        InprocSched*           inproc_sched = nullptr;
+        SLS*                   sls = nullptr;
         CardFinder*            card_finder = nullptr;
         GetClauseQuery*        get_clause_query = nullptr;
 
@@ -276,6 +282,7 @@ class Solver : public Searcher
             , const Lit frat_first = lit_Undef
             , const bool sorted = false
             , const bool remove_frat = false
+            , const bool frat_chain = false
         );
         void add_bnn_clause_inter(
             vector<Lit>& lits,
@@ -357,6 +364,13 @@ class Solver : public Searcher
         PicoSAT* build_picosat();
         void copy_to_simp(SATSolver* s2);
         bool backbone_simpl(int64_t max_confl, bool& finished);
+        lbool find_backbone(
+            const vector<Lit>* assumps,
+            vector<Lit>& backbone,
+            backbone_cb_t cb,
+            void* cb_data,
+            uint64_t max_confl_per_check,
+            double max_time);
         bool removed_var_ext(uint32_t var) const;
 
     private:
@@ -440,8 +454,13 @@ class Solver : public Searcher
             const double cpu_time_total,
             const double wallclock_time_started=0) const;
 
-        lbool simplify_problem(const bool startup, const string& strategy);
-        lbool execute_inprocess_strategy(const bool startup, const string& strategy);
+        lbool simplify_problem(
+            const bool startup, const string& strategy, const bool adaptive = false);
+        lbool execute_inprocess_strategy(
+            const bool startup, const string& strategy, const bool adaptive = false);
+        void update_timeout_multiplier(const bool adaptive, const uint64_t round_ticks);
+        uint64_t last_mult_search_ticks = 0;
+        uint64_t last_mult_search_inproc_ticks = 0;
         SolveStats solveStats;
         void check_minimization_effectiveness(lbool status);
         void check_recursive_minimization_effectiveness(const lbool status);
@@ -485,6 +504,8 @@ class Solver : public Searcher
         // Clauses
         bool add_clause_helper(vector<Lit>& ps);
         bool add_clause_outer(vector<Lit>& ps, const vector<Lit>& outer_ps, bool red = false, bool restore = false);
+        template<class T> bool add_clauses_outside_flat(const T* lits, const size_t num_lits);
+        vector<Lit> add_cls_tmp;
 
         /////////////////
         // Debug
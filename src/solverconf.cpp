@@ -82,6 +82,12 @@ using std::numeric_limits;
 DLL_PUBLIC SolverConf::SolverConf() :
         // Polarities
         polarity_mode(PolarityMode::polarmode_automatic)
+        , do_rephase(1)
+        , rephase_first(1000)
+        , rephase_inc(1.1)
+        , do_mode_switch(1)
+        , mode_switch_first(2000)
+        , mode_switch_inc(1.5)
 
         //Clause cleaning
         , pred_short_size(5500)
@@ -125,12 +131,14 @@ DLL_PUBLIC SolverConf::SolverConf() :
 
         //Restarting
         , restart_first(100)
+        , restart_first_stable(1000)
         , restart_inc(1.1)
         , restartType(Restart::automatic)
         , do_blocking_restart(1)
         , blocking_restart_trail_hist_length(5000)
         , blocking_restart_multip(1.4)
         , fixed_restart_num_confl(100)
+        , do_reuse_trail(1)
         , local_glue_multiplier(0.80)
         , shortTermHistorySize (50)
         , lower_bound_for_blocking_restart(10000)
@@ -139,11 +147,13 @@ DLL_PUBLIC SolverConf::SolverConf() :
 
         //branch strategy
         , branch_strategy_setup("vmtf+vsids")
+        , vsids_heap_arity(2)
 
         //Clause minimisation
         , doRecursiveMinim (true)
         , doMinimRedMore(true)
         , doMinimRedMoreMore(2)
+        , doShrinkMinim(1)
         , max_glue_more_minim(6)
         , max_size_more_minim(30)
         , more_red_minim_limit_binary(200)
@@ -168,6 +178,7 @@ DLL_PUBLIC SolverConf::SolverConf() :
 
         //Chono BT
         , diff_declev_for_chrono (20)
+        , confl_to_chrono(0)
 
         //decision-based clause generation. These values have been validated
         //see 8099966.wlm01
@@ -296,6 +307,14 @@ DLL_PUBLIC SolverConf::SolverConf() :
             "bosphorus,"
             "louvain-comms,"
         )
+        , stream_simplify_every_n_cls(0)
+        //Only cheap steps: the CNF is still incomplete
+        , simplify_schedule_stream(
+            "sub-impl, scc-vrepl, occ-backw-sub"
+        )
+        , adaptive_sched(true)
+        , adaptive_sched_max_mult(4.0)
+        , adaptive_sched_retry(4)
 
         //Occur based simplification
         , perform_occur_based_simp(true)
@@ -318,6 +337,7 @@ DLL_PUBLIC SolverConf::SolverConf() :
         , sls_how_many_to_bump(100)
         , sls_bump_var_max_n_times(100)
         , sls_bump_type(6)
+        , sls_walkers(1)
 
         //Distillation
         , do_distill_clauses(true)
@@ -336,6 +356,9 @@ DLL_PUBLIC SolverConf::SolverConf() :
         #else
         , distill_sort(1)
         #endif
+        , do_vivify_learnt(1)
+        , vivify_learnt_effort(0.03)
+        , vivify_learnt_every(10000)
 
         //Memory savings
         , doRenumberVars   (true)
@@ -358,6 +381,7 @@ DLL_PUBLIC SolverConf::SolverConf() :
         , global_timeout_multiplier(1.0) // WILL BE UNSET, NOT RELEVANT
         , global_timeout_multiplier_multiplier(1.1)
         , global_multiplier_multiplier_max(3)
+        , inprocess_effort_ratio(1.0)
         , var_and_mem_out_mult(1.0)
 
         //Multi-thread, MPI
@@ -369,10 +393,13 @@ DLL_PUBLIC SolverConf::SolverConf() :
         // Oracle
         , oracle_get_learnts(false) // get oracle learnt clauses
         , oracle_removed_is_learnt(false) // clauses removed by Oracle should be learnt
+        , oracle_threads(1) // threads for oracle vivification/sparsification
 
         //misc
         , origSeed(0)
         , simulate_frat(false)
+        , idrup(false)
+        , async_proof_bufs(8)
 {
     ratio_keep_clauses[clean_to_int(ClauseClean::glue)] = 0;
     ratio_keep_clauses[clean_to_int(ClauseClean::activity)] = 0.44;
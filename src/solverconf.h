@@ -81,6 +81,8 @@ inline std::string polarity_mode_to_long_string(PolarityMode polarmode)
             return "saved-polar";
         case PolarityMode::polarmode_weighted :
             return "weighted";
+        case PolarityMode::polarmode_target :
+            return "target";
         case PolarityMode::polarmode_rnd :
             return "rnd";
     }
@@ -133,6 +135,8 @@ inline std::string polarity_mode_to_short_string(PolarityMode polarmode)
             return "pos";
         case PolarityMode::polarmode_weighted :
             return "wght";
+        case PolarityMode::polarmode_target :
+            return "trgt";
         case PolarityMode::polarmode_saved :
             return "svd";
         case PolarityMode::polarmode_rnd :
@@ -230,6 +234,12 @@ class DLL_PUBLIC SolverConf
 
         //Variable polarities
         PolarityMode polarity_mode;
+        int      do_rephase; ///<With 'auto' polarity: phase saving, reset periodically to original/inverted/best/walk/random phases
+        uint64_t rephase_first;
+        double   rephase_inc;
+        int      do_mode_switch; ///<With 'vmtf+vsids' branching and 'auto' restarts: alternate focused and stable search modes
+        uint64_t mode_switch_first;
+        double   mode_switch_inc;
 
         //Clause cleaning
         uint32_t pred_short_size;
@@ -278,12 +288,14 @@ class DLL_PUBLIC SolverConf
 
         //For restarting
         unsigned    restart_first;      ///<The initial restart limit.                                                                (default 100)
+        unsigned    restart_first_stable; ///<Luby restart unit in stable search mode                                                 (default 1000)
         double    restart_inc;        ///<The factor with which the restart limit is multiplied in each restart.                    (default 1.5)
         Restart  restartType;   ///<If set, the solver will always choose the given restart strategy
         int      do_blocking_restart;
         unsigned blocking_restart_trail_hist_length;
         double   blocking_restart_multip;
         uint32_t fixed_restart_num_confl;
+        int      do_reuse_trail; ///<Partial restarts: keep the decisions that would be taken again
 
 
         double   local_glue_multiplier;
@@ -294,11 +306,13 @@ class DLL_PUBLIC SolverConf
 
         //Branch strategy
         string branch_strategy_setup;
+        unsigned vsids_heap_arity; ///<2, 4 or 8
 
         //Clause minimisation
         int doRecursiveMinim;
         int doMinimRedMore;  ///<Perform learnt clause minimisation using watchists' binary and tertiary clauses? ("strong minimization" in PrecoSat)
         int doMinimRedMoreMore;
+        int doShrinkMinim; ///<Replace the lits of a level in the learnt clause with the UIP of that level ("shrinking")
         unsigned max_glue_more_minim;
         unsigned max_size_more_minim;
         unsigned more_red_minim_limit_binary;
@@ -324,6 +338,7 @@ class DLL_PUBLIC SolverConf
 
         //chrono bt
         int diff_declev_for_chrono;
+        int64_t confl_to_chrono;
 
         //decision-based conflict clause generation
         int       do_decision_based_cl;
@@ -436,6 +451,11 @@ class DLL_PUBLIC SolverConf
         uint32_t max_num_simplify_per_solve_call;
         string   simplify_schedule_startup;
         string   simplify_schedule_nonstartup;
+        uint64_t stream_simplify_every_n_cls; //0 == never simplify while clauses are being added
+        string   simplify_schedule_stream;
+        int      adaptive_sched; //scale schedule steps' limits by how much they pay off
+        double   adaptive_sched_max_mult;
+        uint32_t adaptive_sched_retry; //retry a step that stopped paying off after N skips
 
         //Simplification
         int      perform_occur_based_simp;
@@ -458,6 +478,7 @@ class DLL_PUBLIC SolverConf
         uint32_t sls_how_many_to_bump;
         uint32_t sls_bump_var_max_n_times;
         uint32_t sls_bump_type;
+        uint32_t sls_walkers;
 
         //Distillation
         int      do_distill_clauses;
@@ -472,6 +493,9 @@ class DLL_PUBLIC SolverConf
         double distill_irred_noremove_ratio;
         int    distill_rand_shuffle_order_every_n;
         int    distill_sort;
+        int    do_vivify_learnt;
+        double vivify_learnt_effort; ///<Bogoprops of vivification per bogoprop spent since the last one
+        unsigned vivify_learnt_every;
 
         //Memory savings
         int       doRenumberVars;
@@ -504,6 +528,7 @@ class DLL_PUBLIC SolverConf
         double global_timeout_multiplier;
         double global_timeout_multiplier_multiplier;
         double global_multiplier_multiplier_max;
+        double inprocess_effort_ratio; //inprocessing ticks per search tick, 0 = don't steer
         double var_and_mem_out_mult;
 
         //Multi-thread, MPI
@@ -515,11 +540,13 @@ class DLL_PUBLIC SolverConf
         // Oracle
         int oracle_get_learnts; // get oracle learnt clauses
         int oracle_removed_is_learnt; // clauses removed by Oracle should be learnt
+        uint32_t oracle_threads; // threads for oracle vivification/sparsification
 
         //Misc
         unsigned origSeed;
         int      simulate_frat;
         int      idrup;
+        uint32_t async_proof_bufs; // 0 = write proof from the solver thread
         int      conf_needed = true;
 };
 
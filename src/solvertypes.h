@@ -479,6 +479,13 @@ inline vector<Lit> vars_to_lits(const T& vars)
     return ret;
 }
 
+// Flat clause buffers end each clause with lit_Undef, or with 0 when they
+// hold DIMACS-style int32_t literals
+inline bool is_flat_cl_end(const Lit lit) { return lit == lit_Undef; }
+inline bool is_flat_cl_end(const int32_t lit) { return lit == 0; }
+inline Lit flat_to_lit(const Lit lit) { return lit; }
+inline Lit flat_to_lit(const int32_t lit) { return Lit(std::abs(lit)-1, lit < 0); }
+
 inline double float_div(const double a, const double b)
 {
     if (b != 0)
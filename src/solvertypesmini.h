@@ -257,6 +257,7 @@ enum class PolarityMode {
     , polarmode_best
     , polarmode_saved
     , polarmode_weighted
+    , polarmode_target
 };
 
 enum class rst_dat_type {norm, var, cl};
@@ -276,6 +277,20 @@ struct FastBackwData {
     uint64_t start_sumConflicts;
 };
 
+//Snapshot of an ongoing solve() or simplify(), see
+//SATSolver::set_progress_callback()
+struct SolveProgress {
+    uint64_t conflicts = 0;
+    uint64_t decisions = 0;
+    uint64_t propagations = 0;
+    uint64_t restarts = 0;
+    uint32_t free_vars = 0;
+    int64_t sls_best_cost = -1; //fewest unsat clauses found by the last SLS run, -1 if none ran yet
+};
+typedef void (*progress_cb_t)(const SolveProgress& progress, void* user_data);
+//Called with each backbone literal as it's proven. Return false to stop early.
+typedef bool (*backbone_cb_t)(Lit lit, void* user_data);
+
 class BNN
 {
 public:
@@ -74,6 +74,7 @@ bool StrImplWImpl::str_impl_w_impl()
     }
 
 end:
+    solver->add_inproc_ticks(orig_time, timeAvailable);
 
     if (solver->conf.verbosity) {
         str_impl_data.print(
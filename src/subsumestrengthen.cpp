@@ -259,6 +259,7 @@ void SubsumeStrengthen::backw_sub_long_with_long()
     const double time_used = cpuTime() - my_time;
     const bool time_out = (*simplifier->limit_to_decrease <= 0);
     const double time_remain = float_div(*simplifier->limit_to_decrease, orig_limit);
+    solver->add_inproc_ticks(orig_limit, *simplifier->limit_to_decrease);
     if (solver->conf.verbosity) {
         cout
         << "c [occ-backw-sub-long-w-long] rem cl: " << sub0ret.numSubsumed
@@ -325,6 +326,7 @@ bool SubsumeStrengthen::backw_str_long_with_long()
     const double time_used = cpuTime() - my_time;
     const bool time_out = *simplifier->limit_to_decrease <= 0;
     const double time_remain = float_div(*simplifier->limit_to_decrease, orig_limit);
+    solver->add_inproc_ticks(orig_limit, *simplifier->limit_to_decrease);
 
     if (solver->conf.verbosity) {
         cout
@@ -499,6 +501,7 @@ bool SubsumeStrengthen::handle_added_long_cl(const bool verbose)
         cl->stats.marked_clause = 0;
     }
     simplifier->added_long_cl.clear();
+    solver->add_inproc_ticks(orig_limit, *simplifier->limit_to_decrease);
 
     if (verbose) {
         const bool time_out =  *simplifier->limit_to_decrease <= 0;
@@ -949,6 +952,7 @@ bool SubsumeStrengthen::backw_sub_str_long_with_bins()
     const double time_used = cpuTime() - my_time;
     const bool time_out = *simplifier->limit_to_decrease <= 0;
     const double time_remain = float_div(*simplifier->limit_to_decrease, orig_time_limit);
+    solver->add_inproc_ticks(orig_time_limit, *simplifier->limit_to_decrease);
     if (solver->conf.verbosity) {
         cout
         << "c [occ-backw-sub-str-long-w-bins]"
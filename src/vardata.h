@@ -40,6 +40,7 @@ struct VarData
         stable_polarity = false;
         best_polarity = false;
         inv_polarity = false;
+        target_polarity = false;
 #ifdef WEIGHTED
         orig_varnum = num;
 #endif
@@ -69,6 +70,7 @@ struct VarData
     uint8_t saved_polarity:1;
     uint8_t best_polarity:1;
     uint8_t inv_polarity:1;
+    uint8_t target_polarity:1;
     uint8_t is_bva:1;
     uint8_t occ_simp_tried:1;
     bool propagated = false;
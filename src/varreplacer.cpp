@@ -148,6 +148,7 @@ void VarReplacer::update_vardata( const Lit orig , const Lit replaced_with) {
 
 bool VarReplacer::enqueueDelayedEnqueue() {
     for(auto& l: delayedEnqueue) {
+        const Lit orig = get<0>(l);
         get<0>(l) = get_lit_replaced_with(get<0>(l));
 
         if (!solver->ok) {
@@ -157,6 +158,13 @@ bool VarReplacer::enqueueDelayedEnqueue() {
         }
 
         if (solver->value(get<0>(l)) == l_Undef) {
+            if (solver->frat->enabled() && !solver->frat->incremental()
+                && get<0>(l) == orig
+            ) {
+                // the unit keeps its ID, no need to re-add it
+                solver->enqueue_frat_unit(get<0>(l), get<1>(l), solver->decisionLevel());
+                continue;
+            }
             solver->enqueue<false>(get<0>(l));
             // enqueue will add unit, we can delete below
             *solver->frat << del << get<1>(l) << get<0>(l) << fin;
@@ -296,6 +304,29 @@ void VarReplacer::delete_frat_cls()
 	  *solver->frat << del << std::get<0>(f) << std::get<1>(f) << std::get<2>(f) << fin;
       }
     bins_for_frat.clear();
+    frat_edges.clear();
+}
+
+// Appends to solver->chain the hints that take "lit" to what it's replaced
+// with: the unit of the replacement if it's false, then the equivalence
+// binaries from the root down to "lit"
+void VarReplacer::add_frat_repl_chain(Lit lit)
+{
+    const Lit repl = get_lit_replaced_with_fast(lit);
+    if (solver->value(repl) == l_False) {
+        assert(solver->unit_cl_IDs[repl.var()] != 0);
+        solver->chain.push_back(solver->unit_cl_IDs[repl.var()]);
+    }
+
+    const size_t at = solver->chain.size();
+    for(auto it = frat_edges.find(lit.var())
+        ; it != frat_edges.end()
+        ; it = frat_edges.find(lit.var())
+    ) {
+        solver->chain.push_back(lit.sign() ? get<2>(it->second) : get<1>(it->second));
+        lit = get<0>(it->second) ^ lit.sign();
+    }
+    std::reverse(solver->chain.begin()+at, solver->chain.end());
 }
 
 // Returns FALSE if the XOR needs to be removed
@@ -403,7 +434,15 @@ inline void VarReplacer::updateBin(
 
     //Two lits are the same in BIN
     if (lit1 == lit2) {
-        *solver->frat << add << ++solver->clauseID << lit2 << fin;
+        solver->chain.clear();
+        if (solver->frat->enabled()) {
+            add_frat_repl_chain(origLit1);
+            add_frat_repl_chain(origLit2);
+            solver->chain.push_back(i->get_ID());
+        }
+        *solver->frat << add << ++solver->clauseID << lit2;
+        solver->add_chain();
+        *solver->frat << fin;
         delayedEnqueue.push_back(make_pair(lit2, solver->clauseID));
         remove = true;
     }
@@ -431,7 +470,15 @@ inline void VarReplacer::updateBin(
         const int32_t orig_ID = i->get_ID();
         const int32_t ID = ++solver->clauseID;
         /* cout << "orig ID: " << orig_ID << " origl1, l2: " << origLit1 << "," << origLit2 << " lit1, lit2: " << lit1 << "," << lit2 << " new ID: " << ID << endl; */
-        *solver->frat<< add << ID << lit1 << lit2 << fin;
+        solver->chain.clear();
+        if (solver->frat->enabled()) {
+            add_frat_repl_chain(origLit1);
+            add_frat_repl_chain(origLit2);
+            solver->chain.push_back(orig_ID);
+        }
+        *solver->frat << add << ID << lit1 << lit2;
+        solver->add_chain();
+        *solver->frat << fin;
         *solver->frat<< del << i->get_ID() << origLit1 << origLit2 << fin;
         Watched* i2 = findWatchedOfBinMaybe(solver->watches, origLit2, origLit1, i->red(), orig_ID);
         if (i2) i2->set_ID(ID);
@@ -609,7 +656,9 @@ bool VarReplacer::replace_set(vector<ClOffset>& cs) {
         const Lit origLit1 = c[0];
         const Lit origLit2 = c[1];
 
+        solver->chain.clear();
         for (Lit& l: c) {
+            if (solver->frat->enabled()) add_frat_repl_chain(l);
             if (isReplaced_fast(l)) {
                 changed = true;
                 l = get_lit_replaced_with_fast(l);
@@ -690,8 +739,11 @@ bool VarReplacer::handleUpdatedClause(
         return true;
     }
 
+    solver->chain.push_back(c.stats.ID);
     INC_ID(c);
-    (*solver->frat) << add << c << fin << findelay;
+    (*solver->frat) << add << c;
+    solver->add_chain();
+    (*solver->frat) << fin << findelay;
 
     runStats.bogoprops += 3;
     switch(c.size()) {
@@ -942,7 +994,17 @@ bool VarReplacer::replace( uint32_t var1 , uint32_t var2 , const bool xor_is_tru
 
     const Lit lit1_outer = solver->map_inter_to_outer(lit1);
     const Lit lit2_outer = solver->map_inter_to_outer(lit2);
-    return update_table_and_reversetable(lit1_outer, lit2_outer);
+    const bool ret = update_table_and_reversetable(lit1_outer, lit2_outer);
+    if (solver->frat->enabled()) {
+        if (table[lit1_outer.var()].var() != lit1_outer.var()) {
+            frat_edges[lit1.var()] = make_tuple(lit2 ^ lit1.sign()
+                , lit1.sign() ? ID2 : ID, lit1.sign() ? ID : ID2);
+        } else {
+            frat_edges[lit2.var()] = make_tuple(lit1 ^ lit2.sign()
+                , lit2.sign() ? ID : ID2, lit2.sign() ? ID2 : ID);
+        }
+    }
+    return ret;
 }
 
 bool VarReplacer::update_table_and_reversetable(const Lit lit1, const Lit lit2)
@@ -221,6 +221,7 @@ class VarReplacer
         void updateStatsFromImplStats();
 
         bool handleUpdatedClause(Clause& c, const Lit origLit1, const Lit origLit2);
+        void add_frat_repl_chain(Lit lit);
 
          //While replacing the implicit clauses we cannot enqeue
         vector<std::tuple<Lit, int32_t>> delayedEnqueue;
@@ -243,6 +244,10 @@ class VarReplacer
 
         //FRAT
         vector<tuple<int32_t, Lit, Lit>> bins_for_frat;
+        ///Equivalence each replaced var was found with, for the FRAT hints
+        //Everything is INTER here.
+        //Index by: frat_edges[VAR] -> (parent, ID of (~VAR V parent), ID of (VAR V ~parent))
+        map<uint32_t, tuple<Lit, int32_t, int32_t>> frat_edges;
 
         //Stats
         void printReplaceStats() const;
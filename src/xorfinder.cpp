@@ -157,6 +157,7 @@ bool XorFinder::find_xors() {
     //Print stats
     const bool time_out = (xor_find_time_limit < 0);
     const double time_remain = float_div(xor_find_time_limit, orig_xor_find_time_limit);
+    solver->add_inproc_ticks(orig_xor_find_time_limit, xor_find_time_limit);
     runStats.findTime = cpuTime() - my_time;
     runStats.time_outs += time_out;
     solver->print_xors(solver->xorclauses);
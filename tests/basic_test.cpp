@@ -29,6 +29,8 @@ THE SOFTWARE.
 #include "src/solverconf.h"
 #include "test_helper.h"
 #include <vector>
+#include <random>
+#include <algorithm>
 
 using namespace CMSat;
 using std::vector;
@@ -112,6 +114,32 @@ TEST(normal_interface, solve_multi_thread)
     EXPECT_EQ(s.get_model()[1], l_True);
 }
 
+TEST(normal_interface, frat_multi_thread)
+{
+    FILE* os = tmpfile();
+    {
+        SATSolver s;
+        s.set_frat(os);
+        s.set_num_threads(3);
+        s.new_vars(2);
+        s.add_clause(str_to_cl("1, 2"));
+        s.add_clause(str_to_cl("1, -2"));
+        s.add_clause(str_to_cl("-1, 2"));
+        s.add_clause(str_to_cl("-1, -2"));
+        EXPECT_EQ(s.solve(), l_False);
+    }
+
+    //All threads write into the same proof
+    rewind(os);
+    char line[1024];
+    uint32_t num_orig = 0;
+    while(fgets(line, sizeof(line), os)) {
+        if (line[0] == 'o') num_orig++;
+    }
+    EXPECT_EQ(num_orig, 3u*4u);
+    fclose(os);
+}
+
 TEST(normal_interface, logfile)
 {
     SATSolver* s = new SATSolver();
@@ -205,6 +233,299 @@ TEST(normal_interface, max_time)
     EXPECT_EQ(ret, l_True);
 }
 
+TEST(normal_interface, add_clauses_flat)
+{
+    SATSolver s;
+    s.new_vars(3);
+    vector<Lit> cls = {
+        Lit(0, false), Lit(1, false), lit_Undef,
+        Lit(0, true), lit_Undef,
+        Lit(1, true), Lit(2, false), lit_Undef};
+    s.add_clauses(cls.data(), cls.size());
+    lbool ret = s.solve();
+    EXPECT_EQ( ret, l_True);
+    EXPECT_EQ(s.get_model()[0], l_False);
+    EXPECT_EQ(s.get_model()[1], l_True);
+    EXPECT_EQ(s.get_model()[2], l_True);
+}
+
+TEST(normal_interface, add_clauses_dimacs)
+{
+    SATSolver s;
+    s.new_vars(2);
+    vector<int32_t> cls = {1, 2, 0, -1, 0, -2};
+    s.add_clauses(cls.data(), cls.size());
+    lbool ret = s.solve();
+    EXPECT_EQ( ret, l_False);
+    EXPECT_EQ( s.okay(), false);
+}
+
+TEST(normal_interface, add_clauses_dimacs_multi_thread)
+{
+    SATSolver s;
+    s.set_num_threads(2);
+    s.new_vars(2);
+    vector<int32_t> cls = {1, 2, 0, -1, 0};
+    s.add_clauses(cls.data(), cls.size());
+    lbool ret = s.solve();
+    EXPECT_EQ( ret, l_True);
+    EXPECT_EQ(s.get_model()[0], l_False);
+    EXPECT_EQ(s.get_model()[1], l_True);
+}
+
+static void add_equiv_and_filler(SATSolver& s)
+{
+    s.new_vars(10);
+    //v0 == v1
+    s.add_clause(vector<Lit>{Lit(0, false), Lit(1, true)});
+    s.add_clause(vector<Lit>{Lit(0, true), Lit(1, false)});
+    for(uint32_t i = 2; i < 8; i++) {
+        s.add_clause(vector<Lit>{Lit(i, false), Lit(i+1, false), Lit(i+2, true)});
+    }
+}
+
+TEST(normal_interface, stream_simplify_off)
+{
+    SATSolver s;
+    add_equiv_and_filler(s);
+    EXPECT_EQ(s.get_all_binary_xors().size(), 0u);
+}
+
+TEST(normal_interface, stream_simplify)
+{
+    SATSolver s;
+    s.set_stream_simplify(4);
+    add_equiv_and_filler(s);
+    //Fired while adding, found v0 == v1
+    EXPECT_EQ(s.get_all_binary_xors().size(), 1u);
+
+    s.add_clause(vector<Lit>{Lit(0, false)});
+    lbool ret = s.solve();
+    EXPECT_EQ(ret, l_True);
+    EXPECT_EQ(s.get_model()[1], l_True);
+
+    s.add_clause(vector<Lit>{Lit(1, true)});
+    ret = s.solve();
+    EXPECT_EQ(ret, l_False);
+}
+
+//Pigeons into one hole fewer: UNSAT, but takes plenty of conflicts
+static void add_php(SATSolver& s, const uint32_t holes)
+{
+    const uint32_t pigeons = holes+1;
+    s.new_vars(pigeons*holes);
+    vector<Lit> cl;
+    for(uint32_t p = 0; p < pigeons; p++) {
+        cl.clear();
+        for(uint32_t h = 0; h < holes; h++) cl.push_back(Lit(p*holes+h, false));
+        s.add_clause(cl);
+    }
+    for(uint32_t h = 0; h < holes; h++) {
+        for(uint32_t p = 0; p < pigeons; p++) {
+            for(uint32_t p2 = p+1; p2 < pigeons; p2++) {
+                s.add_clause(vector<Lit>{Lit(p*holes+h, true), Lit(p2*holes+h, true)});
+            }
+        }
+    }
+}
+
+struct ProgressSeen {
+    uint32_t calls = 0;
+    uint64_t last_conflicts = 0;
+    bool monotone = true;
+};
+
+static void count_progress(const SolveProgress& p, void* user_data)
+{
+    ProgressSeen* seen = (ProgressSeen*)user_data;
+    seen->calls++;
+    seen->monotone &= p.conflicts >= seen->last_conflicts;
+    seen->last_conflicts = p.conflicts;
+}
+
+TEST(normal_interface, progress_callback)
+{
+    SATSolver s;
+    add_php(s, 8);
+    ProgressSeen seen;
+    s.set_progress_callback(count_progress, &seen);
+    s.set_max_confl(20000);
+    s.solve();
+    EXPECT_GT(seen.calls, 1u);
+    EXPECT_TRUE(seen.monotone);
+    EXPECT_GT(seen.last_conflicts, 0u);
+
+    const uint32_t calls = seen.calls;
+    s.set_progress_callback(nullptr);
+    s.set_max_confl(1000);
+    s.solve();
+    EXPECT_EQ(seen.calls, calls);
+}
+
+TEST(normal_interface, solve_async_cancel)
+{
+    SATSolver s;
+    add_php(s, 10);
+    //Cancelled before the search even started
+    std::future<lbool> f = s.solve_async();
+    s.interrupt_asap();
+    EXPECT_EQ(f.get(), l_Undef);
+
+    //Solver is still usable
+    s.set_max_confl(100);
+    vector<Lit> assumps = {Lit(0, false)};
+    f = s.solve_async(&assumps);
+    assumps.clear();
+    EXPECT_EQ(f.get(), l_Undef);
+    EXPECT_TRUE(s.okay());
+}
+
+TEST(normal_interface, solve_async_sat)
+{
+    SATSolver s;
+    s.new_vars(2);
+    s.add_clause(vector<Lit>{Lit(0, false), Lit(1, false)});
+    vector<Lit> assumps = {Lit(0, true)};
+    std::future<lbool> f = s.solve_async(&assumps);
+    EXPECT_EQ(f.get(), l_True);
+    EXPECT_EQ(s.get_model()[1], l_True);
+}
+
+static vector<Lit> sorted_lits(vector<Lit> lits)
+{
+    std::sort(lits.begin(), lits.end());
+    return lits;
+}
+
+TEST(backbone, simple)
+{
+    SATSolver s;
+    s.new_vars(5);
+    s.add_clause(vector<Lit>{Lit(0, false)});
+    s.add_clause(vector<Lit>{Lit(0, true), Lit(1, false)});
+    s.add_clause(vector<Lit>{Lit(2, false), Lit(3, false)});
+    s.add_clause(vector<Lit>{Lit(1, true), Lit(4, true)});
+    vector<Lit> bb;
+    EXPECT_EQ(s.find_backbone(bb), l_True);
+    EXPECT_EQ(sorted_lits(bb), sorted_lits({Lit(0, false), Lit(1, false), Lit(4, true)}));
+
+    //Solver is still usable, nothing got fixed that shouldn't be
+    vector<Lit> assumps = {Lit(2, true), Lit(3, true)};
+    EXPECT_EQ(s.solve(&assumps), l_False);
+}
+
+TEST(backbone, assumptions)
+{
+    SATSolver s;
+    s.new_vars(4);
+    s.add_clause(vector<Lit>{Lit(0, false), Lit(1, false)});
+    s.add_clause(vector<Lit>{Lit(1, true), Lit(2, false), Lit(3, false)});
+    vector<Lit> assumps = {Lit(0, true)};
+    vector<Lit> bb;
+    EXPECT_EQ(s.find_backbone(bb, &assumps), l_True);
+    EXPECT_EQ(sorted_lits(bb), sorted_lits({Lit(0, true), Lit(1, false)}));
+
+    //The backbone under the assumptions did not stick
+    EXPECT_EQ(s.find_backbone(bb), l_True);
+    EXPECT_TRUE(bb.empty());
+}
+
+TEST(backbone, unsat)
+{
+    SATSolver s;
+    s.new_vars(2);
+    s.add_clause(vector<Lit>{Lit(0, false)});
+    s.add_clause(vector<Lit>{Lit(0, true), Lit(1, false)});
+    vector<Lit> assumps = {Lit(1, true)};
+    vector<Lit> bb;
+    EXPECT_EQ(s.find_backbone(bb, &assumps), l_False);
+    EXPECT_TRUE(bb.empty());
+    EXPECT_TRUE(s.okay());
+}
+
+TEST(backbone, check_limit_not_kept)
+{
+    SATSolver s;
+    add_php(s, 6);
+    vector<Lit> bb;
+    EXPECT_EQ(s.find_backbone(bb, nullptr, nullptr, nullptr, 10), l_Undef);
+    //The per-check limit did not stick
+    EXPECT_EQ(s.solve(), l_False);
+}
+
+TEST(backbone, user_limit)
+{
+    SATSolver s;
+    add_php(s, 8);
+    s.set_max_confl(10);
+    vector<Lit> bb;
+    EXPECT_EQ(s.find_backbone(bb), l_Undef);
+    EXPECT_LT(s.get_sum_conflicts(), 100u);
+}
+
+static bool stop_at_first(Lit, void* user_data)
+{
+    (*(uint32_t*)user_data)++;
+    return false;
+}
+
+TEST(backbone, callback_stops)
+{
+    SATSolver s;
+    s.new_vars(3);
+    for(uint32_t i = 0; i < 3; i++) s.add_clause(vector<Lit>{Lit(i, false)});
+    uint32_t calls = 0;
+    vector<Lit> bb;
+    EXPECT_EQ(s.find_backbone(bb, nullptr, stop_at_first, &calls), l_Undef);
+    EXPECT_EQ(calls, 1u);
+    EXPECT_EQ(bb.size(), 1u);
+}
+
+TEST(backbone, random_vs_enumeration)
+{
+    const uint32_t n = 12;
+    std::mt19937 mtrand(3);
+    for(uint32_t round = 0; round < 20; round++) {
+        SATSolver s;
+        s.new_vars(n);
+        vector<vector<Lit>> cls;
+        for(uint32_t i = 0; i < 40; i++) {
+            vector<Lit> cl;
+            for(uint32_t j = 0; j < 3; j++) cl.push_back(Lit(mtrand()%n, mtrand()%2));
+            cls.push_back(cl);
+            s.add_clause(cl);
+        }
+
+        //Brute force: the literals of the first model no other model flips
+        bool sat = false;
+        vector<lbool> fixed(n, l_Undef);
+        vector<bool> flipped(n, false);
+        for(uint32_t m = 0; m < (1U << n); m++) {
+            bool ok = true;
+            for(const auto& cl: cls) {
+                bool cl_sat = false;
+                for(const Lit l: cl) cl_sat |= (((m >> l.var()) & 1) != 0) != l.sign();
+                if (!cl_sat) {ok = false; break;}
+            }
+            if (!ok) continue;
+            for(uint32_t v = 0; v < n; v++) {
+                const lbool val = boolToLBool((m >> v) & 1);
+                if (!sat) fixed[v] = val;
+                else if (fixed[v] != val) flipped[v] = true;
+            }
+            sat = true;
+        }
+        vector<Lit> expected;
+        for(uint32_t v = 0; v < n; v++) {
+            if (sat && !flipped[v]) expected.push_back(Lit(v, fixed[v] == l_False));
+        }
+
+        vector<Lit> bb;
+        EXPECT_EQ(s.find_backbone(bb), sat ? l_True : l_False);
+        EXPECT_EQ(sorted_lits(bb), expected);
+    }
+}
+
 bool is_critical(const std::range_error&) { return true; }
 
 TEST(xor_interface, xor_check_sat_solution)
@@ -684,17 +1005,28 @@ TEST(error_throw, multithread_0)
         , std::runtime_error);
 }
 
-TEST(error_throw, multithread_drat)
+TEST(error_throw, multithread_idrup)
 {
     SATSolver s;
     FILE* os = NULL;
-    s.set_frat(os);
+    s.set_idrup(os);
 
     EXPECT_THROW({
         s.set_num_threads(3);}
         , std::runtime_error);
 }
 
+TEST(error_throw, add_clauses_dimacs_too_large_var)
+{
+    SATSolver s;
+    s.new_vars(2);
+    vector<int32_t> cls = {1, -3, 0};
+
+    EXPECT_THROW({
+        s.add_clauses(cls.data(), cls.size());}
+        , std::runtime_error);
+}
+
 TEST(error_throw, toomany_vars)
 {
     SATSolver s;
@@ -25,8 +25,13 @@ THE SOFTWARE.
 #include "cryptominisat5/cryptominisat.h"
 
 #include "src/heap.h"
+#include <vector>
+#include <random>
+#include <chrono>
+#include <limits>
 
 using CMSat::Heap;
+using std::vector;
 
 struct Comp
 {
@@ -94,6 +99,121 @@ TEST(heap_minim, inserted_inside)
     EXPECT_EQ(heap.inHeap(20), true);
 }
 
+TEST(heap_minim, arity_sorted)
+{
+    for(uint32_t arity: {2, 4, 8}) {
+        Comp cmp;
+        Heap<Comp> heap(cmp);
+        heap.set_arity(arity);
+        for(size_t i = 0; i < 1000; i++) {
+            heap.insert((i*7919) % 1000);
+        }
+        EXPECT_EQ(heap.heap_property(), true);
+        for(int i = 0; i < 1000; i++) {
+            EXPECT_EQ(heap.removeMin(), i);
+        }
+        EXPECT_EQ(heap.empty(), true);
+    }
+}
+
+TEST(heap_minim, arity_change_with_elements)
+{
+    Comp cmp;
+    Heap<Comp> heap(cmp);
+    for(size_t i = 0; i < 100; i++) heap.insert(99-i);
+    heap.set_arity(8);
+    EXPECT_EQ(heap.arity(), 8u);
+    EXPECT_EQ(heap.heap_property(), true);
+    heap.set_arity(4);
+    EXPECT_EQ(heap.heap_property(), true);
+    for(int i = 0; i < 100; i++) {
+        EXPECT_EQ(heap.removeMin(), i);
+    }
+}
+
+struct ActLt
+{
+    ActLt(const vector<double>& _act) : act(_act) {}
+    bool operator()(uint32_t a, uint32_t b) const
+    {
+        return act[a] > act[b];
+    }
+    const vector<double>& act;
+};
+
+TEST(heap_maxim, arity_bump)
+{
+    for(uint32_t arity: {2, 4, 8}) {
+        vector<double> act(500, 0);
+        Heap<ActLt> heap((ActLt(act)));
+        heap.set_arity(arity);
+        for(uint32_t i = 0; i < act.size(); i++) heap.insert(i);
+
+        std::mt19937 mtrand(arity);
+        for(uint32_t i = 0; i < 5000; i++) {
+            const uint32_t v = mtrand() % act.size();
+            act[v] += 1.0 + (mtrand() % 10);
+            heap.decrease(v);
+        }
+        EXPECT_EQ(heap.heap_property(), true);
+
+        double last = std::numeric_limits<double>::max();
+        while(!heap.empty()) {
+            const uint32_t v = heap.removeMin();
+            EXPECT_LE(act[v], last);
+            last = act[v];
+        }
+    }
+}
+
+// Decision-heavy workload: bump the variables of each "conflict", then
+// take a batch of "decisions" and put them back on "backtrack".
+// Run with --gtest_also_run_disabled_tests to see bump/removeMin throughput.
+TEST(heap_maxim, DISABLED_vsids_throughput)
+{
+    const uint32_t num_vars = 2*1000*1000;
+    for(uint32_t arity: {2, 4, 8}) {
+        vector<double> act(num_vars, 0);
+        Heap<ActLt> heap((ActLt(act)));
+        heap.set_arity(arity);
+        for(uint32_t i = 0; i < num_vars; i++) heap.insert(i);
+
+        std::mt19937 mtrand(1);
+        double inc = 1.0;
+        uint64_t bumps = 0;
+        uint64_t removes = 0;
+        vector<uint32_t> decided;
+        const auto start = std::chrono::steady_clock::now();
+        for(uint32_t confl = 0; confl < 20000; confl++) {
+            for(uint32_t i = 0; i < 100; i++) {
+                const uint32_t v = mtrand() % (num_vars/10);
+                act[v] += inc;
+                if (heap.inHeap(v)) heap.decrease(v);
+                bumps++;
+            }
+            inc *= 1.05;
+            if (inc > 1e100) {
+                for(auto& a: act) a *= 1e-100;
+                inc *= 1e-100;
+            }
+
+            for(uint32_t i = 0; i < 100 && !heap.empty(); i++) {
+                decided.push_back(heap.removeMin());
+                removes++;
+            }
+            for(const auto v: decided) heap.insert(v);
+            decided.clear();
+        }
+        const double secs = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start).count();
+        EXPECT_EQ(heap.heap_property(), true);
+        std::cout << "arity " << arity
+        << " bumps: " << bumps << " removeMin: " << removes
+        << " T: " << secs << " s"
+        << " ops/s: " << (double)(bumps+removes)/secs << std::endl;
+    }
+}
+
 int main(int argc, char **argv) {
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();